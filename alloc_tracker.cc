@@ -0,0 +1,163 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief AllocTracker Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "alloc_tracker.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <new>
+#include <atomic>
+
+// nothing here may allocate through new, it is what new calls
+static std::atomic<unsigned int> g_allocs[kAllocTag_Count];
+static std::atomic<unsigned int> g_bytes[kAllocTag_Count];
+static std::atomic<unsigned int> g_frees(0);
+static std::atomic<unsigned int> g_strict_mask(0);
+static AllocStats g_last_frame[kAllocTag_Count];
+static thread_local AllocTag t_tag = kAllocTag_Untagged;
+static thread_local bool t_reporting = false;
+
+static void* Allocate(size_t size) {
+
+  const AllocTag tag = t_tag;
+  g_allocs[tag].fetch_add(1, std::memory_order_relaxed);
+  g_bytes[tag].fetch_add((unsigned int)size, std::memory_order_relaxed);
+
+  if ((g_strict_mask.load(std::memory_order_relaxed) & (1 << tag)) &&
+      !t_reporting){
+    t_reporting = true;
+    fprintf(stderr, "Error: %u bytes allocated under '%s' in a strict "
+            "frame\n", (unsigned int)size, AllocTagName(tag));
+    t_reporting = false;
+    assert(!"allocation in a strict frame");
+  }
+
+  return malloc(size == 0 ? 1 : size);
+}
+
+static void Release(void* memory) {
+
+  if (memory == nullptr){ return; }
+
+  g_frees.fetch_add(1, std::memory_order_relaxed);
+  free(memory);
+}
+
+/** global hooks **/
+void* operator new(size_t size) {
+
+  void* memory = Allocate(size);
+  if (memory == nullptr){ throw std::bad_alloc(); }
+
+  return memory;
+}
+
+void* operator new[](size_t size) {
+
+  void* memory = Allocate(size);
+  if (memory == nullptr){ throw std::bad_alloc(); }
+
+  return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+
+  return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+
+  return Allocate(size);
+}
+
+void operator delete(void* memory) noexcept { Release(memory); }
+void operator delete[](void* memory) noexcept { Release(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+  Release(memory);
+}
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+  Release(memory);
+}
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* memory, size_t) noexcept { Release(memory); }
+void operator delete[](void* memory, size_t) noexcept { Release(memory); }
+#endif
+
+/**
+ * @brief close the frame, its counters become the last frame ones
+ * @param none
+ * @return void
+ **/
+void AllocNewFrame() {
+
+  const unsigned int frees = g_frees.exchange(0);
+  for (unsigned short int i = 0; i < kAllocTag_Count; i++){
+    g_last_frame[i].allocs_ = g_allocs[i].exchange(0);
+    g_last_frame[i].bytes_ = g_bytes[i].exchange(0);
+    g_last_frame[i].frees_ = 0;
+  }
+  g_last_frame[kAllocTag_Untagged].frees_ = frees;
+}
+
+/**
+ * @brief tag the allocations of this thread from now on
+ * @param const AllocTag tag
+ * @return AllocTag the previous one
+ **/
+AllocTag AllocSetTag(const AllocTag tag) {
+
+  const AllocTag previous = t_tag;
+  t_tag = tag;
+
+  return previous;
+}
+
+/**
+ * @brief assert on any allocation under the given tags, 0 turns it off
+ * @param const unsigned int tag_mask (1 << AllocTag)
+ * @return void
+ **/
+void AllocSetStrict(const unsigned int tag_mask) {
+
+  g_strict_mask = tag_mask;
+}
+
+/** getters **/
+const AllocStats& AllocLastFrame(const AllocTag tag) {
+
+  return g_last_frame[tag];
+}
+
+const unsigned int AllocLastFrameCount() {
+
+  unsigned int count = 0;
+  for (unsigned short int i = 0; i < kAllocTag_Count; i++){
+    count += g_last_frame[i].allocs_;
+  }
+
+  return count;
+}
+
+const unsigned int AllocStrictMask() {
+
+  return g_strict_mask;
+}
+
+const char* AllocTagName(const AllocTag tag) {
+
+  const char* kNames[kAllocTag_Count] = {
+    "Untagged",
+    "Game",
+    "Physics",
+    "Render",
+    "Audio"
+  };
+
+  return kNames[tag];
+}
@@ -0,0 +1,73 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief AllocTracker Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __ALLOCTRACKER_H__
+#define __ALLOCTRACKER_H__ 1
+
+/**
+ * alloc_tracker.cc replaces the global operator new / delete, every
+ * allocation made through them is counted per frame under the tag of the
+ * scope that made it. malloc is not seen, chipmunk counts its own.
+ **/
+
+static enum AllocTag {
+  kAllocTag_Untagged = 0, // libraries, other threads, outside the frame
+  kAllocTag_Game,
+  kAllocTag_Physics,
+  kAllocTag_Render,
+  kAllocTag_Audio,
+  kAllocTag_Count
+};
+
+struct AllocStats {
+  unsigned int allocs_;
+  unsigned int frees_; // not tagged, the tag of a block is not kept
+  unsigned int bytes_;
+};
+
+/**
+ * @brief close the frame, its counters become the last frame ones
+ * @param none
+ * @return void
+ **/
+void AllocNewFrame();
+
+/**
+ * @brief tag the allocations of this thread from now on
+ * @param const AllocTag tag
+ * @return AllocTag the previous one
+ **/
+AllocTag AllocSetTag(const AllocTag tag);
+
+/**
+ * @brief assert on any allocation under the given tags, 0 turns it off
+ * @param const unsigned int tag_mask (1 << AllocTag)
+ * @return void
+ **/
+void AllocSetStrict(const unsigned int tag_mask);
+
+/** getters **/
+const AllocStats& AllocLastFrame(const AllocTag tag);
+const unsigned int AllocLastFrameCount(); // every tag
+const unsigned int AllocStrictMask();
+const char* AllocTagName(const AllocTag tag);
+
+/// tags the allocations of a scope
+class AllocScope {
+
+  public:
+
+    AllocScope(const AllocTag tag) : previous_(AllocSetTag(tag)) {}
+    ~AllocScope() { AllocSetTag(previous_); }
+
+  private:
+
+    AllocTag previous_;
+};
+
+#endif
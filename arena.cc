@@ -0,0 +1,155 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Arena Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "arena.h"
+
+/// offset past used that aligns the address, whatever the block start is
+static unsigned int AlignedOffset(const ArenaBlock* block,
+                                  const unsigned int used,
+                                  const unsigned int align) {
+
+  const uintptr_t data = (uintptr_t)(block + 1);
+  const uintptr_t aligned = (data + used + align - 1) &
+                            ~(uintptr_t)(align - 1);
+
+  return (unsigned int)(aligned - data);
+}
+
+/// constructor
+Arena::Arena() {
+
+  first_ = nullptr;
+  current_ = nullptr;
+  finalizers_ = nullptr;
+  block_size_ = 0;
+  used_ = 0;
+  peak_ = 0;
+}
+
+/**
+ * @brief reserve the first block, later ones are only made on overflow
+ * @param const unsigned int block_size (bytes)
+ * @return void
+ **/
+void Arena::init(const unsigned int block_size) {
+
+  block_size_ = block_size;
+
+  first_ = (ArenaBlock*)malloc(sizeof(ArenaBlock) + block_size_);
+  first_->next_ = nullptr;
+  first_->size_ = block_size_;
+  first_->used_ = 0;
+  current_ = first_;
+}
+
+/**
+ * @brief grow the first block to hold bytes, only while the arena is
+ *        empty since live objects can't move
+ * @param const unsigned int bytes
+ * @return void
+ **/
+void Arena::reserve(const unsigned int bytes) {
+
+  if (used_ > 0 || finalizers_ != nullptr){ return; }
+  if (first_ != nullptr && first_->size_ >= bytes){ return; }
+
+  // the kept overflow blocks are covered by the new first one
+  while (first_ != nullptr){
+    ArenaBlock* block = first_;
+    first_ = block->next_;
+    free(block);
+  }
+
+  first_ = (ArenaBlock*)malloc(sizeof(ArenaBlock) + bytes);
+  first_->next_ = nullptr;
+  first_->size_ = bytes;
+  first_->used_ = 0;
+  current_ = first_;
+}
+
+/**
+ * @brief raw memory, valid until the next reset
+ * @param const unsigned int size, const unsigned int align
+ * @return void* never null
+ **/
+void* Arena::allocate(const unsigned int size, const unsigned int align) {
+
+  // malloc and the header size only promise 8 bytes on 32-bit targets,
+  // so the address is aligned rather than the offset
+  unsigned int offset = AlignedOffset(current_, current_->used_, align);
+
+  while (offset + size > current_->size_){
+    // kept blocks are reused after a reset before making a new one
+    if (current_->next_ == nullptr){
+      unsigned int block_size = size + align > block_size_ ?
+                                size + align : block_size_;
+      printf("Warning: level arena overflow, adding %u bytes\n", block_size);
+      ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + block_size);
+      block->next_ = nullptr;
+      block->size_ = block_size;
+      current_->next_ = block;
+    }
+    current_ = current_->next_;
+    current_->used_ = 0;
+    offset = AlignedOffset(current_, 0, align);
+  }
+
+  void* memory = (char*)(current_ + 1) + offset;
+  used_ += offset + size - current_->used_;
+  current_->used_ = offset + size;
+  if (used_ > peak_){ peak_ = used_; }
+
+  return memory;
+}
+
+/// destroy every object, newest first, and rewind to the first byte
+void Arena::reset() {
+
+  while (finalizers_ != nullptr){
+    ArenaFinalizer* finalizer = finalizers_;
+    finalizers_ = finalizer->next_;
+    finalizer->destroy_(finalizer->object_);
+  }
+
+  current_ = first_;
+  if (current_ != nullptr){ current_->used_ = 0; }
+  used_ = 0;
+}
+
+/** getters **/
+const unsigned int Arena::used() {
+
+  return used_;
+}
+
+const unsigned int Arena::capacity() {
+
+  unsigned int capacity = 0;
+  for (ArenaBlock* block = first_; block != nullptr; block = block->next_){
+    capacity += block->size_;
+  }
+
+  return capacity;
+}
+
+const unsigned int Arena::peak() {
+
+  return peak_;
+}
+
+/// destructor
+Arena::~Arena() {
+
+  reset();
+  while (first_ != nullptr){
+    ArenaBlock* block = first_;
+    first_ = block->next_;
+    free(block);
+  }
+  current_ = nullptr;
+}
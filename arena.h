@@ -0,0 +1,108 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Arena Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __ARENA_H__
+#define __ARENA_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+
+/// a chunk of memory handed out front to back
+struct ArenaBlock {
+  ArenaBlock* next_;
+  unsigned int size_; // bytes after the header
+  unsigned int used_;
+};
+
+/// destructor of an object living in the arena, newest first
+struct ArenaFinalizer {
+  void (*destroy_)(void* object);
+  void* object_;
+  ArenaFinalizer* next_;
+};
+
+class Arena {
+
+  public:
+
+    /// constructor & destructor
+    Arena();
+    ~Arena();
+
+    /**
+     * @brief reserve the first block, later ones are only made on overflow
+     * @param const unsigned int block_size (bytes)
+     * @return void
+     **/
+    void init(const unsigned int block_size);
+
+    /**
+     * @brief grow the first block to hold bytes, only while the arena is
+     *        empty since live objects can't move
+     * @param const unsigned int bytes
+     * @return void
+     **/
+    void reserve(const unsigned int bytes);
+
+    /**
+     * @brief raw memory, valid until the next reset
+     * @param const unsigned int size, const unsigned int align
+     * @return void* never null
+     **/
+    void* allocate(const unsigned int size, const unsigned int align = 16);
+
+    /// construct an object in place, its destructor runs on reset
+    template<class T, class... Args>
+    T* create(Args&&... args) {
+      void* memory = allocate(sizeof(T), alignof(T));
+      T* object = new (memory) T(std::forward<Args>(args)...);
+      ArenaFinalizer* finalizer = (ArenaFinalizer*)allocate(
+          sizeof(ArenaFinalizer), alignof(ArenaFinalizer));
+      finalizer->destroy_ = Destroy<T>;
+      finalizer->object_ = object;
+      finalizer->next_ = finalizers_;
+      finalizers_ = finalizer;
+      return object;
+    }
+
+    /// plain data, nothing to destroy
+    template<class T>
+    T* createArray(const unsigned int count) {
+      return (T*)allocate(sizeof(T) * count, alignof(T));
+    }
+
+    /// destroy every object, newest first, and rewind to the first byte
+    void reset();
+
+    /** getters **/
+    const unsigned int used();
+    const unsigned int capacity();
+    const unsigned int peak();
+
+  private:
+
+    /// copy constructor
+    Arena(const Arena& copy);
+    Arena operator=(const Arena& copy);
+
+    template<class T>
+    static void Destroy(void* object) { ((T*)object)->~T(); }
+
+    /// private vars
+    ArenaBlock* first_;
+    ArenaBlock* current_;
+    ArenaFinalizer* finalizers_;
+    unsigned int block_size_;
+    unsigned int used_; // bytes handed out since the last reset
+    unsigned int peak_;
+};
+
+#endif
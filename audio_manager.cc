@@ -8,6 +8,8 @@
 
 #include "audio_manager.h"
 
+#include <chrono>
+
 #if !defined(WITH_WASAPI)
 
 namespace SoLoud {
@@ -29,19 +31,153 @@ AudioManager& AudioManager::instance() {
   return *singleton;
 }
 
+/// voices each category may play at once
+static const unsigned short int kCategoryBudgets[kSoundCategory_Count] = {
+  1, // jingle
+  3, // bounce
+  4, // break
+  2, // powerup
+  1 // death
+};
+
+/// current time in ms
+static const double NowMS() {
+
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 /// constructor
-AudioManager::AudioManager() {
+AudioManager::AudioManager() : is_backend_ready_(false) {
+
+  memset(fx_paths_, 0, sizeof(fx_paths_));
+  memset(music_paths_, 0, sizeof(music_paths_));
+  num_fx_ = 0;
+  num_music_ = 0;
+  backend_ = SoLoud::Soloud::AUTO;
+  clock_ = nullptr;
+  for (unsigned short int i = 0; i < kMaxFX; i++){
+    fx_settings_[i] = { kSoundCategory_Jingle, 0, 0.0 };
+    fx_ready_[i] = false;
+    pending_fx_[i] = 0.0f;
+    last_played_[i] = -1000000.0;
+  }
+  for (unsigned short int i = 0; i < kMaxMusic; i++){
+    music_ready_[i] = false;
+    pending_music_[i] = 0.0f;
+  }
+  for (unsigned short int i = 0; i < kSoundCategory_Count; i++){
+    num_voices_[i] = 0;
+  }
+  stats_ = { 0, 0, 0, 0 };
+}
+
+/**
+ * @brief read the audio manifest and load it in the background, sounds
+ *        asked for before they are ready play once they are
+ * @param LuaWrapper* lua
+ * @return void
+ **/
+void AudioManager::load(LuaWrapper* lua, const unsigned int backend) {
+
+  backend_ = backend;
+
+  // audio_fx: amount, then path, category, priority, window per sample
+  num_fx_ = lua->getIntegerFromTableByIndex("audio_fx", 0);
+  lua->pop(2);
+  if (num_fx_ > kMaxFX){ num_fx_ = kMaxFX; }
+  for (unsigned short int i = 0; i < num_fx_; i++){
+    const short int field = 1 + i * 4;
+    snprintf(fx_paths_[i], 128, "%s",
+             lua->getStringFromTableByIndex("audio_fx", field));
+    lua->pop(2);
+    int category = lua->getIntegerFromTableByIndex("audio_fx", field + 1);
+    lua->pop(2);
+    if (category < 0 || category >= kSoundCategory_Count){ category = 0; }
+    fx_settings_[i].category_ = (SoundCategory)category;
+    fx_settings_[i].priority_ = lua->getIntegerFromTableByIndex("audio_fx",
+                                                                field + 2);
+    lua->pop(2);
+    fx_settings_[i].window_ = lua->getNumberFromTableByIndex("audio_fx",
+                                                             field + 3);
+    lua->pop(2);
+  }
+
+  // audio_music: amount, then one path per track
+  num_music_ = lua->getIntegerFromTableByIndex("audio_music", 0);
+  lua->pop(2);
+  if (num_music_ > kMaxMusic){ num_music_ = kMaxMusic; }
+  for (unsigned short int i = 0; i < num_music_; i++){
+    snprintf(music_paths_[i], 128, "%s",
+             lua->getStringFromTableByIndex("audio_music", i + 1));
+    lua->pop(2);
+  }
+
+  // nothing here waits, the game starts while the jobs run
+  Job init = { InitBackend, this, 0, 1, &loading_, nullptr };
+  JOBSYSTEM.run(init);
+  JOBSYSTEM.parallelFor(LoadFX, this, num_fx_, 1, &loading_);
+  JOBSYSTEM.parallelFor(LoadMusic, this, num_music_, 1, &loading_);
 
-  soloud_.init();
-	fx_[0].load("data/assets/sounds/start.wav");
-	fx_[1].load("data/assets/sounds/bounce.wav");
-	fx_[2].load("data/assets/sounds/powerup.wav");
-	fx_[3].load("data/assets/sounds/die.wav");
-	fx_[4].load("data/assets/sounds/break1.wav");
-	fx_[5].load("data/assets/sounds/break2.wav");
-	fx_[6].load("data/assets/sounds/break3.wav");
+  // queued jobs only run on their own when there are workers
+  if (JOBSYSTEM.numWorkers() == 0){ JOBSYSTEM.wait(&loading_); }
+}
+
+/** loading jobs, data is the AudioManager **/
+void AudioManager::InitBackend(void* data,
+                               const unsigned int first,
+                               const unsigned int last) {
+
+  AudioManager* manager = (AudioManager*)data;
+  manager->soloud_.init(SoLoud::Soloud::CLIP_ROUNDOFF, manager->backend_);
+  manager->soloud_.setMaxActiveVoiceCount(kMaxActiveVoices);
+  manager->is_backend_ready_ = true;
+}
+
+void AudioManager::LoadFX(void* data,
+                          const unsigned int first,
+                          const unsigned int last) {
+
+  AudioManager* manager = (AudioManager*)data;
+  for (unsigned int i = first; i < last; i++){
+    manager->fx_[i].load(manager->fx_paths_[i]);
+    manager->fx_ready_[i] = true;
+  }
+}
+
+void AudioManager::LoadMusic(void* data,
+                             const unsigned int first,
+                             const unsigned int last) {
 
-	//music_[0].load("data/assets/sounds/die.wav");
+  // a stream only opens the file here, it is decoded while it plays
+  AudioManager* manager = (AudioManager*)data;
+  for (unsigned int i = first; i < last; i++){
+    manager->music_[i].load(manager->music_paths_[i]);
+    manager->music_ready_[i] = true;
+  }
+}
+
+/// play the requests that arrived before their sample was ready
+void AudioManager::update() {
+
+  if (!is_backend_ready_){ return; }
+
+  AllocScope alloc_scope(kAllocTag_Audio);
+
+  for (unsigned short int i = 0; i < num_fx_; i++){
+    if (pending_fx_[i] > 0.0f && fx_ready_[i]){
+      const float volume = pending_fx_[i];
+      pending_fx_[i] = 0.0f;
+      playFX(i, volume);
+    }
+  }
+  for (unsigned short int i = 0; i < num_music_; i++){
+    if (pending_music_[i] > 0.0f && music_ready_[i]){
+      const float volume = pending_music_[i];
+      pending_music_[i] = 0.0f;
+      playMusic(i, volume);
+    }
+  }
 }
 
 /**
@@ -51,8 +187,72 @@ AudioManager::AudioManager() {
  **/
 void AudioManager::playFX(const unsigned short int index, const float volume) {
 
-  int sample = soloud_.play(fx_[index]);
-  soloud_.setVolume(sample, volume);
+  if (index >= num_fx_){ return; }
+
+  AllocScope alloc_scope(kAllocTag_Audio);
+
+  if (!is_backend_ready_ || !fx_ready_[index]){
+    pending_fx_[index] = volume;
+    return;
+  }
+
+  const SoundSettings& settings = fx_settings_[index];
+  const double now = clock_ != nullptr ? clock_() : NowMS();
+
+  // a burst of the same sound is heard as one
+  if (now - last_played_[index] < settings.window_){
+    stats_.coalesced_++;
+    return;
+  }
+
+  Voice* voice = claimVoice(settings.category_, settings.priority_);
+  if (voice == nullptr){
+    stats_.dropped_++;
+    return;
+  }
+
+  voice->handle_ = soloud_.play(fx_[index], volume);
+  voice->priority_ = settings.priority_;
+  voice->start_ = now;
+  last_played_[index] = now;
+  stats_.played_++;
+}
+
+/**
+ * @brief find a voice slot in the budget of a category, stealing the
+ *        lowest priority (then oldest) voice when it is full
+ * @param const SoundCategory category, const unsigned char priority
+ * @return Voice* (nullptr when every voice outranks the new one)
+ **/
+Voice* AudioManager::claimVoice(const SoundCategory category,
+                                const unsigned char priority) {
+
+  Voice* voices = voices_[category];
+  unsigned short int& count = num_voices_[category];
+
+  // forget the voices that already finished
+  unsigned short int i = 0;
+  while (i < count){
+    if (soloud_.isValidVoiceHandle(voices[i].handle_)){ i++; }
+    else { voices[i] = voices[--count]; }
+  }
+
+  if (count < kCategoryBudgets[category]){ return &voices[count++]; }
+
+  Voice* victim = &voices[0];
+  for (i = 1; i < count; i++){
+    if (voices[i].priority_ < victim->priority_ ||
+        (voices[i].priority_ == victim->priority_ &&
+         voices[i].start_ < victim->start_)){
+      victim = &voices[i];
+    }
+  }
+  if (victim->priority_ > priority){ return nullptr; }
+
+  soloud_.stop(victim->handle_);
+  stats_.stolen_++;
+
+  return victim;
 }
 
 /**
@@ -63,13 +263,50 @@ void AudioManager::playFX(const unsigned short int index, const float volume) {
 void AudioManager::playMusic(const unsigned short int index,
 														 const float volume) {
 
+  if (index >= num_music_){ return; }
+
+  AllocScope alloc_scope(kAllocTag_Audio);
+
+  if (!is_backend_ready_ || !music_ready_[index]){
+    pending_music_[index] = volume;
+    return;
+  }
+
   int loop = soloud_.play(music_[index]);
   soloud_.setLooping(loop, 1);
 	soloud_.setVolume(loop, volume);
 }
 
+/**
+ * @brief replace the clock used to coalesce sounds, for runs that do
+ *        not play in real time
+ * @param const double (*clock)() (ms, nullptr for the steady clock)
+ * @return void
+ **/
+void AudioManager::set_clock(const double (*clock)()) {
+
+  clock_ = clock;
+}
+
+/** getters **/
+const unsigned int AudioManager::activeVoices() {
+
+  return soloud_.getActiveVoiceCount();
+}
+
+const AudioStats& AudioManager::stats() {
+
+  return stats_;
+}
+
+const bool AudioManager::ready() {
+
+  return loading_.pending_.load() == 0;
+}
+
 /// destructor
 AudioManager::~AudioManager() {
 
+  JOBSYSTEM.wait(&loading_);
   soloud_.deinit();
 }
@@ -9,8 +9,48 @@
 #ifndef __AUDIOMANAGER_H__
 #define __AUDIOMANAGER_H__ 1
 
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+
 #include "soloud.h"
 #include "soloud_wav.h"
+#include "soloud_wavstream.h"
+
+#include "luawrapper.h"
+#include "job_system.h"
+#include "alloc_tracker.h"
+
+/// sounds of a category share a voice budget
+static enum SoundCategory {
+  kSoundCategory_Jingle = 0,
+  kSoundCategory_Bounce,
+  kSoundCategory_Break,
+  kSoundCategory_Powerup,
+  kSoundCategory_Death,
+  kSoundCategory_Count
+};
+
+/// how a sample competes for voices
+struct SoundSettings {
+  SoundCategory category_;
+  unsigned char priority_; // higher steals voices from lower
+  double window_; // ms, repeats inside it are coalesced into one voice
+};
+
+struct Voice {
+  SoLoud::handle handle_;
+  unsigned char priority_;
+  double start_; // ms
+};
+
+/// what happened to the playFX calls that did not start a voice
+struct AudioStats {
+  unsigned int played_;
+  unsigned int coalesced_;
+  unsigned int stolen_;
+  unsigned int dropped_;
+};
 
 class AudioManager {
 
@@ -19,6 +59,19 @@ class AudioManager {
     /// singleton
     static AudioManager& instance();
 
+    /**
+     * @brief read the audio manifest and load it in the background, sounds
+     *        asked for before they are ready play once they are
+     * @param LuaWrapper* lua, const unsigned int backend (SoLoud backend,
+     *        NULLDRIVER mixes only when mix() is called)
+     * @return void
+     **/
+    void load(LuaWrapper* lua,
+              const unsigned int backend = SoLoud::Soloud::AUTO);
+
+    /// play the requests that arrived before their sample was ready
+    void update();
+
     /**
      * @brief play a sound sample with a specified volume
      * @param const unsigned short int index, const float volume
@@ -33,10 +86,29 @@ class AudioManager {
      **/
     void playMusic(const unsigned short int index, const float volume);
 
+    /**
+     * @brief replace the clock used to coalesce sounds, for runs that do
+     *        not play in real time
+     * @param const double (*clock)() (ms, nullptr for the steady clock)
+     * @return void
+     **/
+    void set_clock(const double (*clock)());
+
+    /** getters **/
+    const unsigned int activeVoices();
+    const AudioStats& stats();
+    const bool ready(); // everything in the manifest is loaded
+
+    /// public consts
+    static const unsigned short int kMaxFX = 16;
+    static const unsigned short int kMaxMusic = 4;
+    static const unsigned short int kMaxCategoryVoices = 4;
+    static const unsigned int kMaxActiveVoices = 16;
+
     /// public vars
     SoLoud::Soloud soloud_;
-    SoLoud::Wav fx_[7];
-    SoLoud::Wav music_[0];
+    SoLoud::Wav fx_[kMaxFX]; // decoded in memory, short and frequent
+    SoLoud::WavStream music_[kMaxMusic]; // decoded while it plays
 
   private:
 
@@ -46,6 +118,45 @@ class AudioManager {
     /// copy constructor
     AudioManager(const AudioManager& copy);
 
+    /**
+     * @brief find a voice slot in the budget of a category, stealing the
+     *        lowest priority (then oldest) voice when it is full
+     * @param const SoundCategory category, const unsigned char priority
+     * @return Voice* (nullptr when every voice outranks the new one)
+     **/
+    Voice* claimVoice(const SoundCategory category,
+                      const unsigned char priority);
+
+    /** loading jobs, data is the AudioManager **/
+    static void InitBackend(void* data,
+                            const unsigned int first,
+                            const unsigned int last);
+    static void LoadFX(void* data,
+                       const unsigned int first,
+                       const unsigned int last);
+    static void LoadMusic(void* data,
+                          const unsigned int first,
+                          const unsigned int last);
+
+    /// private vars
+    char fx_paths_[kMaxFX][128];
+    char music_paths_[kMaxMusic][128];
+    SoundSettings fx_settings_[kMaxFX];
+    unsigned short int num_fx_;
+    unsigned short int num_music_;
+    unsigned int backend_;
+    const double (*clock_)();
+    std::atomic<bool> is_backend_ready_;
+    std::atomic<bool> fx_ready_[kMaxFX];
+    std::atomic<bool> music_ready_[kMaxMusic];
+    float pending_fx_[kMaxFX]; // volume, 0 when nothing waits
+    float pending_music_[kMaxMusic];
+    JobCounter loading_;
+    Voice voices_[kSoundCategory_Count][kMaxCategoryVoices];
+    unsigned short int num_voices_[kSoundCategory_Count];
+    double last_played_[kMaxFX]; // ms
+    AudioStats stats_;
+
     /// destructor
     ~AudioManager();
 };
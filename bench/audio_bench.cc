@@ -0,0 +1,224 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Headless audio mixer benchmark
+ * @author Toni Marquez
+ *
+ * Drives AudioManager through SoLoud's null driver with the event
+ * patterns of real play and times every mixed buffer. After every pattern
+ * it reports the latency from a frame firing its sounds to the end of the
+ * buffer that mixes them, in simulated time. Runs from the repository
+ * root (it reads config.lua and the sounds) and needs no sound card.
+ * Build it with the game's alloc_tracker.cc, audio_manager.cc,
+ * job_system.cc, latency_tracker.cc and luawrapper.cc, Lua and SoLoud
+ * compiled WITH_NULL.
+ *
+ *   audio_bench [frames per pattern] [max p99 us per buffer]
+ *
+ * Exits with 1 when a pattern's p99 goes over the given budget.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "audio_manager.h"
+#include "luawrapper.h"
+#include "job_system.h"
+#include "latency_tracker.h"
+
+#define AUDIOMANAGER AudioManager::instance()
+
+/// fx indices of the manifest in config.lua
+static const unsigned short int kFXStart = 0;
+static const unsigned short int kFXBounce = 1;
+static const unsigned short int kFXPowerup = 2;
+static const unsigned short int kFXDie = 3;
+static const unsigned short int kFXBreak = 4; // 3 variations
+
+static const unsigned int kSampleRate = 44100;
+static const unsigned int kBufferSamples = 512; // per channel
+static const float kFrameMS = 1000.0f / 60.0f;
+
+/// simulated time, the coalescing windows follow the frames, not the mix
+static double g_time = 0.0;
+
+const double SimulatedTime() {
+
+  return g_time;
+}
+
+/// current time in microseconds
+const double NowUS() {
+
+  return std::chrono::duration<double, std::micro>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// what a pattern fires on a frame
+typedef void (*Pattern)(const unsigned int frame);
+
+void Idle(const unsigned int frame) {}
+
+/// multiball against the bar and walls, every frame
+void BounceStorm(const unsigned int frame) {
+
+  for (unsigned short int i = 0; i < 24; i++){
+    AUDIOMANAGER.playFX(kFXBounce, 1.0f);
+  }
+}
+
+/// a chain reaction, bursts of breaks every few frames
+void BreakChain(const unsigned int frame) {
+
+  if (frame % 3 != 0){ return; }
+
+  unsigned short int breaks = 8 + rand() % 40;
+  for (unsigned short int i = 0; i < breaks; i++){
+    AUDIOMANAGER.playFX(kFXBreak + rand() % 3, 1.0f);
+  }
+}
+
+/// everything at once, with a death and a level start now and then
+void Mayhem(const unsigned int frame) {
+
+  BounceStorm(frame);
+  BreakChain(frame);
+  if (frame % 7 == 0){ AUDIOMANAGER.playFX(kFXPowerup, 1.0f); }
+  if (frame % 90 == 0){ AUDIOMANAGER.playFX(kFXDie, 1.0f); }
+  if (frame % 240 == 0){ AUDIOMANAGER.playFX(kFXStart, 1.0f); }
+}
+
+struct PatternResult {
+  const char* name_;
+  unsigned int buffers_;
+  double mean_; // us per buffer
+  double p50_;
+  double p99_;
+  double max_;
+  double mean_voices_;
+  unsigned int max_voices_;
+  AudioStats stats_; // delta over the pattern
+};
+
+const double Percentile(std::vector<double>& samples, const double q) {
+
+  if (samples.empty()){ return 0.0; }
+
+  size_t index = (size_t)(q * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+  return samples[index];
+}
+
+/**
+ * @brief fire a pattern for some frames, mixing the audio those frames
+ *        would have produced
+ * @param const char* name, Pattern pattern, const unsigned int frames
+ * @return PatternResult
+ **/
+PatternResult Run(const char* name, Pattern pattern,
+                  const unsigned int frames) {
+
+  static float buffer[kBufferSamples * 2];
+
+  std::vector<double> times;
+  times.reserve(frames * 2);
+
+  AUDIOMANAGER.soloud_.stopAll();
+  const AudioStats before = AUDIOMANAGER.stats();
+  LATENCY.reset();
+
+  PatternResult result;
+  memset(&result, 0, sizeof(result));
+  result.name_ = name;
+
+  double owed = 0.0; // samples the frames produced but not mixed yet
+  unsigned long long voices = 0;
+  for (unsigned int frame = 0; frame < frames; frame++){
+    // what the frame fires is heard at the end of the next mixed buffer
+    const unsigned int sequence = LATENCY.sample(g_time);
+    const unsigned int mixed = times.size();
+    pattern(frame);
+    AUDIOMANAGER.update();
+    g_time += kFrameMS;
+
+    owed += kSampleRate * kFrameMS / 1000.0f;
+    while (owed >= kBufferSamples){
+      double start = NowUS();
+      AUDIOMANAGER.soloud_.mix(buffer, kBufferSamples);
+      times.push_back(NowUS() - start);
+      owed -= kBufferSamples;
+
+      unsigned int active = AUDIOMANAGER.activeVoices();
+      voices += active;
+      if (active > result.max_voices_){ result.max_voices_ = active; }
+    }
+    if (times.size() > mixed){
+      LATENCY.submit(sequence, g_time - owed * 1000.0 / kSampleRate);
+    }
+  }
+
+  const AudioStats& after = AUDIOMANAGER.stats();
+  result.stats_.played_ = after.played_ - before.played_;
+  result.stats_.coalesced_ = after.coalesced_ - before.coalesced_;
+  result.stats_.stolen_ = after.stolen_ - before.stolen_;
+  result.stats_.dropped_ = after.dropped_ - before.dropped_;
+
+  result.buffers_ = times.size();
+  if (result.buffers_ > 0){
+    double total = 0.0;
+    for (unsigned int i = 0; i < times.size(); i++){ total += times[i]; }
+    result.mean_ = total / times.size();
+    result.mean_voices_ = (double)voices / times.size();
+    result.max_ = *std::max_element(times.begin(), times.end());
+    result.p50_ = Percentile(times, 0.50);
+    result.p99_ = Percentile(times, 0.99);
+  }
+
+  return result;
+}
+
+int main(int argc, char** argv) {
+
+  unsigned int frames = argc > 1 ? atoi(argv[1]) : 3600;
+  double budget = argc > 2 ? atof(argv[2]) : 0.0;
+
+  srand(1);
+
+  LuaWrapper lua;
+  lua.init("config.lua");
+
+  AUDIOMANAGER.set_clock(SimulatedTime);
+  AUDIOMANAGER.load(&lua, SoLoud::Soloud::NULLDRIVER);
+  while (!AUDIOMANAGER.ready()){ std::this_thread::yield(); }
+
+  const Pattern kPatterns[] = { Idle, BounceStorm, BreakChain, Mayhem };
+  const char* kNames[] = { "idle", "bounce storm", "break chain", "mayhem" };
+
+  printf("%u frames per pattern, %u samples per buffer at %u Hz\n",
+         frames, kBufferSamples, kSampleRate);
+  printf("%-14s %8s %9s %9s %9s %9s %7s %6s %8s %9s %7s %7s\n",
+         "pattern", "buffers", "mean us", "p50 us", "p99 us", "max us",
+         "voices", "peak", "played", "coalesced", "stolen", "dropped");
+
+  int exit_code = 0;
+  for (unsigned short int i = 0; i < 4; i++){
+    PatternResult r = Run(kNames[i], kPatterns[i], frames);
+    printf("%-14s %8u %9.2f %9.2f %9.2f %9.2f %7.2f %6u %8u %9u %7u %7u\n",
+           r.name_, r.buffers_, r.mean_, r.p50_, r.p99_, r.max_,
+           r.mean_voices_, r.max_voices_, r.stats_.played_,
+           r.stats_.coalesced_, r.stats_.stolen_, r.stats_.dropped_);
+    LATENCY.report(stdout);
+    if (budget > 0.0 && r.p99_ > budget){ exit_code = 1; }
+  }
+
+  JOBSYSTEM.shutdown();
+
+  return exit_code;
+}
@@ -0,0 +1,412 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Headless stress scenario benchmark
+ * @author Toni Marquez
+ *
+ * Plays the scenarios of a scenario file without a window, the autopilot
+ * on the bar, and writes one CSV row per scenario: frame time
+ * percentiles, chipmunk step time, draw commands, allocations, peak RSS
+ * and the autopilot input to frame swap latency (nothing is presented
+ * without a window). Runs from the repository root (it reads config.lua
+ * and the assets). Build it with every game source but main.cc, the same
+ * libraries the game links and SoLoud compiled WITH_NULL.
+ *
+ *   scenario_bench <scenarios.txt> <out.csv> [baseline.csv [tolerance]]
+ *
+ * With a baseline (a CSV written by an earlier run) it exits with 1 when
+ * a scenario's frame p99, mean physics step or peak draw commands go over
+ * the baseline by more than the tolerance (0.1 by default), or when it
+ * allocates more than the baseline did. It also exits with 1 when chipmunk
+ * was built without chipmunk_alloc.h, its allocations would read 0.
+ *
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "luawrapper.h"
+#include "game_manager.h"
+#include "audio_manager.h"
+#include "render_queue.h"
+#include "job_system.h"
+#include "profiler.h"
+#include "alloc_tracker.h"
+#include "chipmunk_alloc.h"
+#include "latency_tracker.h"
+#include "level_generator.h"
+
+#define GAMEMANAGER GameManager::instance()
+
+static const unsigned int kWarmupFrames = 60;
+static const double kFrameMS = 1000.0 / 60.0;
+static const unsigned short int kMaxName = 32;
+
+/// one line of the scenario file
+struct Scenario {
+  char name_[kMaxName];
+  unsigned short int balls_;
+  unsigned int bricks_; // 0 plays the first config.lua level
+  float seconds_;
+  LevelPattern pattern_;
+  unsigned int seed_;
+};
+
+/// one row of the CSV
+struct ScenarioResult {
+  char name_[kMaxName];
+  unsigned short int balls_;
+  unsigned int bricks_; // built, the generator only gets close to the ask
+  unsigned int broken_;
+  float seconds_;
+  unsigned int frames_;
+  double frame_p50_; // ms
+  double frame_p95_;
+  double frame_p99_;
+  double frame_max_;
+  double physics_mean_; // ms per step
+  double physics_p99_;
+  double draws_mean_;
+  unsigned int draws_max_;
+  unsigned int allocs_; // all measured frames, audio left out
+  unsigned int physics_allocs_; // chipmunk slabs from malloc
+  unsigned int peak_rss_kb_; // of the process so far, not of the scenario
+  double latency_p50_; // ms, autopilot input to swapped frame
+  double latency_p99_;
+};
+
+static const char kHeader[] =
+    "scenario,balls,bricks,broken,seconds,frames,frame_p50_ms,frame_p95_ms,"
+    "frame_p99_ms,frame_max_ms,physics_mean_ms,physics_p99_ms,draws_mean,"
+    "draws_max,allocs,physics_allocs,peak_rss_kb,latency_p50_ms,"
+    "latency_p99_ms\n";
+
+const double Percentile(std::vector<double>& samples, const double q) {
+
+  if (samples.empty()){ return 0.0; }
+
+  size_t index = (size_t)(q * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+  return samples[index];
+}
+
+/// highest resident set of the process, in KB
+const unsigned int PeakRSS() {
+
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))){
+    return 0;
+  }
+  return (unsigned int)(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0){ return 0; }
+  return (unsigned int)usage.ru_maxrss; // KB on linux
+#endif
+}
+
+/**
+ * @brief read the scenarios, one per line:
+ *          name balls bricks seconds [pattern [seed]]
+ *        the pattern is a LevelPatternName, '#' starts a comment
+ * @param const char* path, std::vector<Scenario>* scenarios
+ * @return const bool false when the file can't be read
+ **/
+const bool LoadScenarios(const char* path,
+                         std::vector<Scenario>* scenarios) {
+
+  FILE* file = fopen(path, "r");
+  if (file == nullptr){ return false; }
+
+  char line[256];
+  unsigned int number = 0;
+  while (fgets(line, sizeof(line), file) != nullptr){
+    number++;
+    char* comment = strchr(line, '#');
+    if (comment != nullptr){ *comment = '\0'; }
+
+    Scenario scenario;
+    char pattern[kMaxName] = "Noise";
+    unsigned int balls = 0;
+    scenario.seed_ = 1;
+    const int fields = sscanf(line, "%31s %u %u %f %31s %u",
+                              scenario.name_, &balls, &scenario.bricks_,
+                              &scenario.seconds_, pattern, &scenario.seed_);
+    if (fields <= 0){ continue; }
+    if (fields < 4 || balls < 1 || scenario.seconds_ <= 0.0f){
+      fprintf(stderr, "%s:%u: expected name balls bricks seconds "
+              "[pattern [seed]]\n", path, number);
+      continue;
+    }
+    scenario.balls_ = (unsigned short int)balls;
+
+    scenario.pattern_ = kLevelPattern_Count;
+    for (unsigned short int i = 0; i < kLevelPattern_Count; i++){
+      if (!strcmp(pattern, LevelPatternName((LevelPattern)i))){
+        scenario.pattern_ = (LevelPattern)i;
+      }
+    }
+    if (scenario.pattern_ == kLevelPattern_Count){
+      fprintf(stderr, "%s:%u: unknown pattern '%s'\n", path, number,
+              pattern);
+      continue;
+    }
+
+    scenarios->push_back(scenario);
+  }
+  fclose(file);
+
+  return true;
+}
+
+/**
+ * @brief the rows of an earlier run, only the columns that are checked
+ * @param const char* path, std::vector<ScenarioResult>* results
+ * @return const bool false when the file can't be read
+ **/
+const bool LoadBaseline(const char* path,
+                        std::vector<ScenarioResult>* results) {
+
+  FILE* file = fopen(path, "r");
+  if (file == nullptr){ return false; }
+
+  char line[512];
+  while (fgets(line, sizeof(line), file) != nullptr){
+    ScenarioResult result;
+    memset(&result, 0, sizeof(result));
+    const int fields = sscanf(line,
+        "%31[^,],%*u,%*u,%*u,%*f,%*u,%*f,%*f,%lf,%*f,%lf,%*f,%*f,%u,%u,%u",
+        result.name_, &result.frame_p99_, &result.physics_mean_,
+        &result.draws_max_, &result.allocs_, &result.physics_allocs_);
+    if (fields == 6){ results->push_back(result); }
+  }
+  fclose(file);
+
+  return true;
+}
+
+/**
+ * @brief set the scene up as the scenario asks and play it on a fixed
+ *        step; nothing is pushed to the sample vectors past their
+ *        reserve, so the bench allocates nothing the game doesn't
+ * @param EngineScene* scene, const Scenario& scenario
+ * @return ScenarioResult
+ **/
+ScenarioResult Run(EngineScene* scene, const Scenario& scenario) {
+
+  const unsigned int frames = (unsigned int)(scenario.seconds_ * 60.0f);
+
+  std::vector<double> times;
+  std::vector<double> steps;
+  times.reserve(frames);
+  steps.reserve(frames);
+
+  scene->resetGame(1);
+  if (scenario.bricks_ > 0){
+    scene->generateLevel(LevelSpecForBricks(scenario.bricks_,
+                                            scenario.seed_,
+                                            scenario.pattern_));
+  }
+  scene->resetLevel();
+  scene->removeBalls();
+  for (unsigned short int i = 1; i < scenario.balls_; i++){
+    scene->addBall();
+  }
+  // a lost ball would restart the level halfway through the numbers
+  scene->game_state_.godmode_ = true;
+
+  ScenarioResult result;
+  memset(&result, 0, sizeof(result));
+  strncpy(result.name_, scenario.name_, kMaxName - 1);
+  result.balls_ = scenario.balls_;
+  result.bricks_ = scene->game_state_.bricks_amount_;
+  result.seconds_ = scenario.seconds_;
+  result.frames_ = frames;
+
+  unsigned long long draws = 0;
+  for (unsigned int frame = 0; frame < kWarmupFrames + frames; frame++){
+    const double start = Profiler::Now();
+    scene->autopilot();
+    scene->update(kFrameMS);
+    scene->render();
+    RENDERQUEUE.swap();
+    const double end = Profiler::Now();
+    LATENCY.submit(RENDERQUEUE.swappedSequence(), end);
+    AllocNewFrame();
+    ChipmunkAllocNewFrame();
+    if (frame == kWarmupFrames - 1){ LATENCY.reset(); }
+    if (frame < kWarmupFrames){ continue; }
+
+    times.push_back(end - start);
+    steps.push_back(PROFILER.sample(kProfileSection_Physics).last_);
+
+    const unsigned int commands = RENDERQUEUE.numCommands();
+    draws += commands;
+    if (commands > result.draws_max_){ result.draws_max_ = commands; }
+
+    result.allocs_ += AllocLastFrameCount() -
+                      AllocLastFrame(kAllocTag_Audio).allocs_;
+    result.physics_allocs_ += ChipmunkAllocLastFrame().system_allocs_;
+  }
+
+  for (unsigned short int i = 0; i < scene->game_state_.bricks_amount_; i++){
+    if (!scene->game_state_.bricks_[i].is_active_){ result.broken_++; }
+  }
+
+  if (frames > 0){
+    double total = 0.0;
+    for (unsigned int i = 0; i < steps.size(); i++){ total += steps[i]; }
+    result.physics_mean_ = total / steps.size();
+    result.draws_mean_ = (double)draws / frames;
+    result.frame_max_ = *std::max_element(times.begin(), times.end());
+    result.frame_p50_ = Percentile(times, 0.50);
+    result.frame_p95_ = Percentile(times, 0.95);
+    result.frame_p99_ = Percentile(times, 0.99);
+    result.physics_p99_ = Percentile(steps, 0.99);
+  }
+  result.peak_rss_kb_ = PeakRSS();
+  result.latency_p50_ = LATENCY.percentile(0.5f);
+  result.latency_p99_ = LATENCY.percentile(0.99f);
+
+  scene->removeBalls();
+  scene->game_state_.godmode_ = false;
+
+  return result;
+}
+
+/**
+ * @brief compare a result with its baseline row, printing what went over
+ * @param const ScenarioResult& result, const ScenarioResult& baseline,
+ *        const double tolerance
+ * @return const bool true when the result is within the baseline
+ **/
+const bool CheckBaseline(const ScenarioResult& result,
+                         const ScenarioResult& baseline,
+                         const double tolerance) {
+
+  bool passed = true;
+  const double limit = 1.0 + tolerance;
+
+  if (result.frame_p99_ > baseline.frame_p99_ * limit){
+    printf("  %s: frame p99 %.3f ms, baseline %.3f ms\n", result.name_,
+           result.frame_p99_, baseline.frame_p99_);
+    passed = false;
+  }
+  if (result.physics_mean_ > baseline.physics_mean_ * limit){
+    printf("  %s: physics mean %.3f ms, baseline %.3f ms\n", result.name_,
+           result.physics_mean_, baseline.physics_mean_);
+    passed = false;
+  }
+  if (result.draws_max_ > baseline.draws_max_ * limit){
+    printf("  %s: draws max %u, baseline %u\n", result.name_,
+           result.draws_max_, baseline.draws_max_);
+    passed = false;
+  }
+  if (result.allocs_ > baseline.allocs_ ||
+      result.physics_allocs_ > baseline.physics_allocs_){
+    printf("  %s: %u allocs (%u physics), baseline %u (%u physics)\n",
+           result.name_, result.allocs_, result.physics_allocs_,
+           baseline.allocs_, baseline.physics_allocs_);
+    passed = false;
+  }
+
+  return passed;
+}
+
+int main(int argc, char** argv) {
+
+  if (argc < 3){
+    printf("usage: scenario_bench <scenarios.txt> <out.csv> "
+           "[baseline.csv [tolerance]]\n");
+    return 2;
+  }
+  const double tolerance = argc > 4 ? atof(argv[4]) : 0.1;
+
+  std::vector<Scenario> scenarios;
+  if (!LoadScenarios(argv[1], &scenarios)){
+    fprintf(stderr, "Error: can't read '%s'\n", argv[1]);
+    return 2;
+  }
+  std::vector<ScenarioResult> baseline;
+  if (argc > 3 && !LoadBaseline(argv[3], &baseline)){
+    fprintf(stderr, "Error: can't read baseline '%s'\n", argv[3]);
+    return 2;
+  }
+
+  FILE* csv = fopen(argv[2], "w");
+  if (csv == nullptr){
+    fprintf(stderr, "Error: can't write '%s'\n", argv[2]);
+    return 2;
+  }
+  fputs(kHeader, csv);
+
+  srand(0);
+
+  GAMEMANAGER.headless_ = true;
+  Sprite::SetHeadless(true);
+  {
+    LuaWrapper lua;
+    lua.init("config.lua");
+    GAMEMANAGER.init(lua.getGlobalNumber("kNormalWindowWidth"),
+                     lua.getGlobalNumber("kNormalWindowHeight"),
+                     lua.getGlobalNumber("kSleepTime"));
+  }
+  EngineScene* scene = GAMEMANAGER.engine_scene_;
+  scene->init();
+  while (!AUDIOMANAGER.ready()){
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  printf("%-16s %5s %6s %7s %8s %8s %8s %8s %8s %8s %7s %9s\n",
+         "scenario", "balls", "bricks", "broken", "p50 ms", "p95 ms",
+         "p99 ms", "max ms", "phys ms", "draws", "allocs", "rss KB");
+
+  int exit_code = 0;
+  for (unsigned int i = 0; i < scenarios.size(); i++){
+    const ScenarioResult r = Run(scene, scenarios[i]);
+    printf("%-16s %5u %6u %7u %8.3f %8.3f %8.3f %8.3f %8.3f %8.1f %7u "
+           "%9u\n", r.name_, r.balls_, r.bricks_, r.broken_, r.frame_p50_,
+           r.frame_p95_, r.frame_p99_, r.frame_max_, r.physics_mean_,
+           r.draws_mean_, r.allocs_ + r.physics_allocs_, r.peak_rss_kb_);
+    fprintf(csv, "%s,%u,%u,%u,%.2f,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,"
+            "%u,%u,%u,%u,%.2f,%.2f\n", r.name_, r.balls_, r.bricks_,
+            r.broken_, r.seconds_, r.frames_, r.frame_p50_, r.frame_p95_,
+            r.frame_p99_, r.frame_max_, r.physics_mean_, r.physics_p99_,
+            r.draws_mean_, r.draws_max_, r.allocs_, r.physics_allocs_,
+            r.peak_rss_kb_, r.latency_p50_, r.latency_p99_);
+    fflush(csv);
+
+    for (unsigned int j = 0; j < baseline.size(); j++){
+      if (strcmp(baseline[j].name_, r.name_)){ continue; }
+      if (!CheckBaseline(r, baseline[j], tolerance)){ exit_code = 1; }
+    }
+  }
+  fclose(csv);
+
+  if (exit_code != 0){ printf("regressions against '%s'\n", argv[3]); }
+  if (!ChipmunkAllocHooked()){
+    printf("chipmunk allocations are not counted, build it with "
+           "-include chipmunk_alloc.h\n");
+    exit_code = 1;
+  }
+
+  JOBSYSTEM.shutdown();
+  RENDERQUEUE.flush();
+
+  return exit_code;
+}
@@ -0,0 +1,211 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief BrickGrid Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "brick_grid.h"
+
+const short int BrickGrid::kEmpty;
+
+/// constructor
+BrickGrid::BrickGrid() {
+
+  origin_ = gtmath::Vec3Zero();
+  cell_size_ = gtmath::Vec3Zero();
+  brick_half_ = gtmath::Vec3Zero();
+  cols_ = 0;
+  rows_ = 0;
+}
+
+/// init values (origin is the center of the first cell)
+void BrickGrid::init(const unsigned short int cols,
+                     const unsigned short int rows,
+                     const gtmath::Vec3 origin,
+                     const gtmath::Vec3 cell_size,
+                     const gtmath::Vec3 brick_size) {
+
+  cols_ = cols;
+  rows_ = rows;
+  origin_ = origin;
+  cell_size_ = cell_size;
+  cells_.assign(cols_ * rows_, kEmpty);
+  set_brickSize(brick_size);
+}
+
+/// empty every cell
+void BrickGrid::clear() {
+
+  cells_.assign(cols_ * rows_, kEmpty);
+}
+
+/**
+ * @brief sweep a box through the grid, walking only the cells crossed
+ *        by its center (DDA) and testing their neighbourhood
+ * @param const gtmath::Vec3 center, const gtmath::Vec3 half,
+ *        const gtmath::Vec3 delta, GridHit* hit
+ * @return const bool
+ **/
+const bool BrickGrid::sweep(const gtmath::Vec3 center,
+                            const gtmath::Vec3 half,
+                            const gtmath::Vec3 delta,
+                            GridHit* hit) {
+
+  if (cells_.empty()){ return false; }
+
+  // early out when the swept box never touches the grid bounds
+  float left = origin_.x - cell_size_.x / 2 - half.x;
+  float top = origin_.y - cell_size_.y / 2 - half.y;
+  float right = left + cell_size_.x * cols_ + half.x * 2;
+  float bottom = top + cell_size_.y * rows_ + half.y * 2;
+  float min_x = center.x < center.x + delta.x ? center.x : center.x + delta.x;
+  float max_x = center.x < center.x + delta.x ? center.x + delta.x : center.x;
+  float min_y = center.y < center.y + delta.y ? center.y : center.y + delta.y;
+  float max_y = center.y < center.y + delta.y ? center.y + delta.y : center.y;
+  if (max_x < left || min_x > right || max_y < top || min_y > bottom){
+    return false;
+  }
+
+  // grid space position of the center
+  float gx = (center.x - (origin_.x - cell_size_.x / 2)) / cell_size_.x;
+  float gy = (center.y - (origin_.y - cell_size_.y / 2)) / cell_size_.y;
+  int col = (int)floor(gx);
+  int row = (int)floor(gy);
+
+  // how many neighbour cells an inflated brick can spill into
+  int reach_x = (int)floor((brick_half_.x + half.x) / cell_size_.x + 0.5f);
+  int reach_y = (int)floor((brick_half_.y + half.y) / cell_size_.y + 0.5f);
+
+  int step_x = delta.x > 0.0f ? 1 : -1;
+  int step_y = delta.y > 0.0f ? 1 : -1;
+  float t_delta_x = delta.x != 0.0f ? cell_size_.x / fabs(delta.x) : INFINITY;
+  float t_delta_y = delta.y != 0.0f ? cell_size_.y / fabs(delta.y) : INFINITY;
+  float t_max_x = INFINITY;
+  float t_max_y = INFINITY;
+  if (delta.x > 0.0f){ t_max_x = (col + 1 - gx) * t_delta_x; }
+  else if (delta.x < 0.0f){ t_max_x = (gx - col) * t_delta_x; }
+  if (delta.y > 0.0f){ t_max_y = (row + 1 - gy) * t_delta_y; }
+  else if (delta.y < 0.0f){ t_max_y = (gy - row) * t_delta_y; }
+
+  hit->index = kEmpty;
+  hit->toi = INFINITY;
+
+  // a hit at time t is always found from the cell holding the center at t,
+  // so the walk stops as soon as it enters a cell later than the best hit
+  float t_enter = 0.0f;
+  while (t_enter <= 1.0f && t_enter <= hit->toi){
+    testNeighbourhood(col, row, reach_x, reach_y, center, half, delta, hit);
+
+    if (t_max_x < t_max_y){
+      t_enter = t_max_x;
+      t_max_x += t_delta_x;
+      col += step_x;
+    }
+    else {
+      t_enter = t_max_y;
+      t_max_y += t_delta_y;
+      row += step_y;
+    }
+  }
+
+  return hit->index != kEmpty;
+}
+
+/// test the cells around (col, row) keeping the earliest hit
+void BrickGrid::testNeighbourhood(const int col,
+                                  const int row,
+                                  const int reach_x,
+                                  const int reach_y,
+                                  const gtmath::Vec3 center,
+                                  const gtmath::Vec3 half,
+                                  const gtmath::Vec3 delta,
+                                  GridHit* hit) {
+
+  int first_col = col - reach_x < 0 ? 0 : col - reach_x;
+  int first_row = row - reach_y < 0 ? 0 : row - reach_y;
+  int last_col = col + reach_x >= cols_ ? cols_ - 1 : col + reach_x;
+  int last_row = row + reach_y >= rows_ ? rows_ - 1 : row + reach_y;
+
+  SweepHit sweep_hit;
+  for (int r = first_row; r <= last_row; r++){
+    for (int c = first_col; c <= last_col; c++){
+      short int index = cells_[r * cols_ + c];
+      if (index == kEmpty){ continue; }
+
+      if (SweepBox(center, half, delta, cellCenter(c, r), brick_half_,
+                   &sweep_hit) && sweep_hit.toi < hit->toi){
+        hit->index = index;
+        hit->col = c;
+        hit->row = r;
+        hit->toi = sweep_hit.toi;
+        hit->normal = sweep_hit.normal;
+      }
+    }
+  }
+}
+
+/** setters **/
+void BrickGrid::set_cell(const unsigned short int col,
+                         const unsigned short int row,
+                         const short int index) {
+
+  if (col < cols_ && row < rows_){ cells_[row * cols_ + col] = index; }
+}
+
+void BrickGrid::set_brickSize(const gtmath::Vec3 brick_size) {
+
+  brick_half_ = { brick_size.x / 2, brick_size.y / 2, 0.0f };
+}
+
+/** getters **/
+const short int BrickGrid::cell(const unsigned short int col,
+                                const unsigned short int row) {
+
+  if (col < cols_ && row < rows_){ return cells_[row * cols_ + col]; }
+  return kEmpty;
+}
+
+const gtmath::Vec3 BrickGrid::cellCenter(const unsigned short int col,
+                                         const unsigned short int row) {
+
+  gtmath::Vec3 center = { origin_.x + col * cell_size_.x,
+                          origin_.y + row * cell_size_.y,
+                          1.0f };
+
+  return center;
+}
+
+/**
+ * @brief cell under a point
+ * @param const gtmath::Vec3 point, unsigned short int* col,
+ *        unsigned short int* row
+ * @return const bool false when the point is off the grid
+ **/
+const bool BrickGrid::cellAt(const gtmath::Vec3 point,
+                             unsigned short int* col,
+                             unsigned short int* row) {
+
+  float gx = (point.x - (origin_.x - cell_size_.x / 2)) / cell_size_.x;
+  float gy = (point.y - (origin_.y - cell_size_.y / 2)) / cell_size_.y;
+  if (gx < 0.0f || gy < 0.0f || gx >= cols_ || gy >= rows_){ return false; }
+
+  *col = (unsigned short int)gx;
+  *row = (unsigned short int)gy;
+
+  return true;
+}
+
+const unsigned short int BrickGrid::cols() {
+
+  return cols_;
+}
+
+const unsigned short int BrickGrid::rows() {
+
+  return rows_;
+}
+
+/// destructor
+BrickGrid::~BrickGrid() {}
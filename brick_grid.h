@@ -0,0 +1,108 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief BrickGrid Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __BRICKGRID_H__
+#define __BRICKGRID_H__ 1
+
+#include <math.h>
+#include <vector>
+
+#include "gtmath.h"
+#include "sweep.h"
+
+struct GridHit {
+  short int index; // brick index stored in the hit cell
+  unsigned short int col;
+  unsigned short int row;
+  float toi;
+  gtmath::Vec3 normal;
+};
+
+class BrickGrid {
+
+  public:
+
+    /// constructor & destructor
+    BrickGrid();
+    ~BrickGrid();
+
+    /// init values (origin is the center of the first cell)
+    void init(const unsigned short int cols,
+              const unsigned short int rows,
+              const gtmath::Vec3 origin,
+              const gtmath::Vec3 cell_size,
+              const gtmath::Vec3 brick_size);
+
+    /// empty every cell
+    void clear();
+
+    /**
+     * @brief sweep a box through the grid, walking only the cells crossed
+     *        by its center (DDA) and testing their neighbourhood
+     * @param const gtmath::Vec3 center, const gtmath::Vec3 half,
+     *        const gtmath::Vec3 delta, GridHit* hit
+     * @return const bool
+     **/
+    const bool sweep(const gtmath::Vec3 center,
+                     const gtmath::Vec3 half,
+                     const gtmath::Vec3 delta,
+                     GridHit* hit);
+
+    /** setters **/
+    void set_cell(const unsigned short int col,
+                  const unsigned short int row,
+                  const short int index);
+    void set_brickSize(const gtmath::Vec3 brick_size);
+
+    /** getters **/
+    const short int cell(const unsigned short int col,
+                         const unsigned short int row);
+    const gtmath::Vec3 cellCenter(const unsigned short int col,
+                                  const unsigned short int row);
+
+    /**
+     * @brief cell under a point
+     * @param const gtmath::Vec3 point, unsigned short int* col,
+     *        unsigned short int* row
+     * @return const bool false when the point is off the grid
+     **/
+    const bool cellAt(const gtmath::Vec3 point,
+                      unsigned short int* col,
+                      unsigned short int* row);
+    const unsigned short int cols();
+    const unsigned short int rows();
+
+    /// public consts
+    static const short int kEmpty = -1;
+
+  private:
+
+    /// copy constructor
+    BrickGrid(const BrickGrid& copy);
+    BrickGrid operator=(const BrickGrid& copy);
+
+    /// test the cells around (col, row) keeping the earliest hit
+    void testNeighbourhood(const int col,
+                           const int row,
+                           const int reach_x,
+                           const int reach_y,
+                           const gtmath::Vec3 center,
+                           const gtmath::Vec3 half,
+                           const gtmath::Vec3 delta,
+                           GridHit* hit);
+
+    /// private vars
+    std::vector<short int> cells_;
+    gtmath::Vec3 origin_;
+    gtmath::Vec3 cell_size_;
+    gtmath::Vec3 brick_half_;
+    unsigned short int cols_;
+    unsigned short int rows_;
+};
+
+#endif
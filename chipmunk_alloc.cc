@@ -0,0 +1,203 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ChipmunkAlloc Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "chipmunk_alloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+
+/// payload sizes, anything bigger goes straight to malloc
+static const unsigned short int kNumClasses = 8;
+static const size_t kClassSizes[kNumClasses] = {
+  16, 32, 64, 128, 256, 512, 1024, 2048
+};
+static const size_t kSlabSize = 64 * 1024;
+
+/// in front of every block, keeps the payload 16 aligned
+struct ChipmunkBlock {
+  size_t class_; // kNumClasses for big blocks
+  size_t size_; // requested
+};
+
+/// free blocks reuse their payload as the link
+struct ChipmunkFreeBlock {
+  ChipmunkFreeBlock* next_;
+};
+
+static ChipmunkFreeBlock* g_free_lists[kNumClasses] = { nullptr };
+static ChipmunkAllocStats g_frame = { 0, 0, 0, 0, 0 };
+static ChipmunkAllocStats g_last_frame = { 0, 0, 0, 0, 0 };
+static ChipmunkAllocStats g_total = { 0, 0, 0, 0, 0 };
+static size_t g_live_bytes = 0;
+// main thread while loading, simulation thread after, never contended
+static std::mutex g_mutex;
+
+static void CountSystem(const size_t bytes) {
+
+  g_frame.system_allocs_++;
+  g_frame.system_bytes_ += bytes;
+  g_total.system_allocs_++;
+  g_total.system_bytes_ += bytes;
+}
+
+/// carve a new slab into free blocks of one class
+static void Refill(const unsigned short int size_class) {
+
+  const size_t stride = sizeof(ChipmunkBlock) + kClassSizes[size_class];
+  const size_t count = kSlabSize / stride;
+
+  char* slab = (char*)malloc(stride * count);
+  if (slab == nullptr){ return; }
+  CountSystem(stride * count);
+
+  for (size_t i = 0; i < count; i++){
+    ChipmunkBlock* block = (ChipmunkBlock*)(slab + i * stride);
+    block->class_ = size_class;
+    ChipmunkFreeBlock* free_block = (ChipmunkFreeBlock*)(block + 1);
+    free_block->next_ = g_free_lists[size_class];
+    g_free_lists[size_class] = free_block;
+  }
+}
+
+static void* Allocate(const size_t size) {
+
+  unsigned short int size_class = 0;
+  while (size_class < kNumClasses && kClassSizes[size_class] < size){
+    size_class++;
+  }
+
+  ChipmunkBlock* block = nullptr;
+  if (size_class == kNumClasses){
+    block = (ChipmunkBlock*)malloc(sizeof(ChipmunkBlock) + size);
+    if (block == nullptr){ return nullptr; }
+    CountSystem(sizeof(ChipmunkBlock) + size);
+  }
+  else {
+    if (g_free_lists[size_class] == nullptr){ Refill(size_class); }
+    ChipmunkFreeBlock* free_block = g_free_lists[size_class];
+    if (free_block == nullptr){ return nullptr; }
+    g_free_lists[size_class] = free_block->next_;
+    block = (ChipmunkBlock*)free_block - 1;
+  }
+  block->class_ = size_class;
+  block->size_ = size;
+
+  g_frame.allocs_++;
+  g_frame.bytes_ += size;
+  g_total.allocs_++;
+  g_total.bytes_ += size;
+  g_live_bytes += size;
+
+  return block + 1;
+}
+
+static void Release(void* memory) {
+
+  ChipmunkBlock* block = (ChipmunkBlock*)memory - 1;
+
+  g_frame.frees_++;
+  g_total.frees_++;
+  g_live_bytes -= block->size_;
+
+  if (block->class_ == kNumClasses){
+    free(block);
+    return;
+  }
+
+  ChipmunkFreeBlock* free_block = (ChipmunkFreeBlock*)memory;
+  free_block->next_ = g_free_lists[block->class_];
+  g_free_lists[block->class_] = free_block;
+}
+
+void* ChipmunkCalloc(size_t count, size_t size) {
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  void* memory = Allocate(count * size);
+  if (memory != nullptr){ memset(memory, 0, count * size); }
+
+  return memory;
+}
+
+void* ChipmunkRealloc(void* memory, size_t size) {
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  if (memory == nullptr){ return Allocate(size); }
+  if (size == 0){
+    Release(memory);
+    return nullptr;
+  }
+
+  // still fits its class, nothing to move
+  ChipmunkBlock* block = (ChipmunkBlock*)memory - 1;
+  if (block->class_ < kNumClasses && size <= kClassSizes[block->class_]){
+    g_live_bytes += size - block->size_;
+    block->size_ = size;
+    return memory;
+  }
+
+  void* moved = Allocate(size);
+  if (moved == nullptr){ return nullptr; }
+  memcpy(moved, memory, block->size_ < size ? block->size_ : size);
+  Release(memory);
+
+  return moved;
+}
+
+void ChipmunkFree(void* memory) {
+
+  if (memory == nullptr){ return; }
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  Release(memory);
+}
+
+/**
+ * @brief close the frame, its counters become the last frame ones
+ * @param none
+ * @return void
+ **/
+void ChipmunkAllocNewFrame() {
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  g_last_frame = g_frame;
+  memset(&g_frame, 0, sizeof(g_frame));
+}
+
+/** getters **/
+const ChipmunkAllocStats& ChipmunkAllocLastFrame() {
+
+  return g_last_frame;
+}
+
+const ChipmunkAllocStats& ChipmunkAllocTotal() {
+
+  return g_total;
+}
+
+const size_t ChipmunkAllocLiveBytes() {
+
+  return g_live_bytes;
+}
+
+/**
+ * @brief cpSpaceNew always allocates, so no allocation after one means
+ * chipmunk was built without this header and every counter reads 0
+ * @param none
+ * @return const bool true when chipmunk allocates through the pool
+ **/
+const bool ChipmunkAllocHooked() {
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+
+  return g_total.allocs_ > 0;
+}
@@ -0,0 +1,69 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ChipmunkAlloc Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __CHIPMUNKALLOC_H__
+#define __CHIPMUNKALLOC_H__ 1
+
+#include <stddef.h>
+
+/**
+ * chipmunk only calls cpcalloc / cprealloc / cpfree, defined before
+ * chipmunk.h they reach the engine pool. The chipmunk sources have to be
+ * built with this header forced in too (-include / /FI), or bodies made
+ * there would be freed into the wrong allocator.
+ **/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* ChipmunkCalloc(size_t count, size_t size);
+void* ChipmunkRealloc(void* memory, size_t size);
+void ChipmunkFree(void* memory);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define cpcalloc ChipmunkCalloc
+#define cprealloc ChipmunkRealloc
+#define cpfree ChipmunkFree
+
+#ifdef __cplusplus
+
+/// what chipmunk asked for, per frame and overall
+struct ChipmunkAllocStats {
+  unsigned int allocs_;
+  unsigned int frees_;
+  unsigned int bytes_; // requested
+  unsigned int system_allocs_; // slabs and big blocks from malloc
+  unsigned int system_bytes_;
+};
+
+/**
+ * @brief close the frame, its counters become the last frame ones
+ * @param none
+ * @return void
+ **/
+void ChipmunkAllocNewFrame();
+
+/** getters **/
+const ChipmunkAllocStats& ChipmunkAllocLastFrame();
+const ChipmunkAllocStats& ChipmunkAllocTotal();
+const size_t ChipmunkAllocLiveBytes();
+
+/**
+ * @brief cpSpaceNew always allocates, so no allocation after one means
+ * chipmunk was built without this header and every counter reads 0
+ * @param none
+ * @return const bool true when chipmunk allocates through the pool
+ **/
+const bool ChipmunkAllocHooked();
+
+#endif
+
+#endif
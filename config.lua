@@ -36,7 +36,8 @@ ball_settings = {
   friction = 0.0,
   elasticity = 1.0,
   speed = 200.0,
-  infinity = true
+  infinity = true,
+  ccd = true -- sub-step around impacts when the ball is fast enough to tunnel
 };
 
 -- wall
@@ -50,7 +51,34 @@ wall_settings = {
 brick_settings = {
   mass = 10.0,
   friction = 0.0,
-  elasticity = 1.0
+  elasticity = 1.0,
+  analytic = false -- ball vs bricks through the grid instead of chipmunk
+};
+
+--[[
+- @title audio manifest, loaded in the background at startup
+- @brief - first value is the amount of entries
+         - fx entry: path, category, priority, window (ms)
+         - categories: 0 jingle, 1 bounce, 2 break, 3 powerup, 4 death
+         - a higher priority steals voices from a lower one, repeats of a
+           sample inside its window play as one
+         - fx are played by their position, starting at 0
+         - music entry: path, streamed from disk while it plays
+--]]
+
+audio_fx = {
+  7,
+  "data/assets/sounds/start.wav", 0, 3, 0.0,
+  "data/assets/sounds/bounce.wav", 1, 1, 50.0,
+  "data/assets/sounds/powerup.wav", 3, 2, 50.0,
+  "data/assets/sounds/die.wav", 4, 3, 200.0,
+  "data/assets/sounds/break1.wav", 2, 1, 30.0,
+  "data/assets/sounds/break2.wav", 2, 1, 30.0,
+  "data/assets/sounds/break3.wav", 2, 1, 30.0
+};
+
+audio_music = {
+  0
 };
 
 --[[
@@ -60,6 +88,9 @@ brick_settings = {
          - second value is the amount of bricks excluding gaps (0)
          - kind of bricks: 1, 2, 3, 4, 5, 6 & 7
          - to place a gap must put a 0
+         - the level editor (debug mode) saves to data/levels/levelN.lua,
+           a table there replaces the one here
+         - a table with cols and rows fields is that size instead of 10 * 7
 --]]
 
 kTotalLevels = 4; -- change if a level is added or removed
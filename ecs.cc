@@ -0,0 +1,186 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ECS Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "ecs.h"
+#include "sprite.h"
+#include "profiler.h"
+
+/// job syncing the physics components [first, last) of the world
+static void SyncTransformsJob(void* data, const unsigned int first,
+                              const unsigned int last) {
+
+  ((World*)data)->syncRange(first, last);
+}
+
+/// constructor
+World::World() {
+
+  next_ = 0;
+  alive_ = 0;
+}
+
+/// singleton
+World& World::instance() {
+
+  static World* singleton = new World();
+  return *singleton;
+}
+
+/**
+ * @brief a new entity, with no components
+ * @param none
+ * @return Entity
+ **/
+Entity World::create() {
+
+  Entity entity = next_;
+  if (!free_.empty()){
+    entity = free_.back();
+    free_.pop_back();
+  }
+  else {
+    next_++;
+  }
+  alive_++;
+
+  return entity;
+}
+
+/// remove every component of the entity, its id is reused after
+void World::destroy(const Entity entity) {
+
+  if (entity == kNoEntity){ return; }
+
+  for (unsigned short int i = 0; i < kDrawLayer_Count; i++){
+    if (sprites_[i].has(entity)){
+      Sprite::Release(sprites_[i].get(entity).handle_);
+    }
+    sprites_[i].remove(entity);
+    colliders_[i].remove(entity);
+  }
+  transforms_.remove(entity);
+  physics_.remove(entity);
+  tags_.remove(entity);
+  free_.push_back(entity);
+  alive_--;
+}
+
+/// keeps up to count entities drawn on a layer from allocating
+void World::reserve(const unsigned int count, const DrawLayer layer) {
+
+  transforms_.reserve(count);
+  physics_.reserve(count);
+  sprites_[layer].reserve(count);
+  colliders_[layer].reserve(count);
+  tags_.reserve(count);
+  free_.reserve(count);
+}
+
+/**
+ * @brief copy every body position and angle into its transform,
+ *        spread on the job system
+ * @param none
+ * @return void
+ **/
+void World::syncTransforms() {
+
+  const unsigned int kBodiesPerJob = 32;
+
+  // only the enqueue is scheduling overhead, the wait is the sync itself
+  JobCounter bodies;
+  PROFILER.begin(kProfileSection_Jobs);
+  JOBSYSTEM.parallelFor(SyncTransformsJob, this, physics_.size(),
+                        kBodiesPerJob, &bodies);
+  PROFILER.end(kProfileSection_Jobs);
+  JOBSYSTEM.wait(&bodies);
+}
+
+/**
+ * @brief sync a range of physics components
+ * @param const unsigned int first, const unsigned int last (excluded)
+ * @return void
+ **/
+void World::syncRange(const unsigned int first, const unsigned int last) {
+
+  for (unsigned int i = first; i < last; i++){
+    const cpBody* body = physics_.at(i).body_;
+    const cpVect position = cpBodyGetPosition(body);
+    TransformComponent& transform = transforms_.get(physics_.owner(i));
+    transform.x_ = (float)position.x;
+    transform.y_ = (float)position.y;
+    transform.angle_ = (float)cpBodyGetAngle(body);
+  }
+}
+
+/**
+ * @brief record the sprites and colliders of a layer into the render
+ *        queue, as last synced; only that layer's arrays are walked
+ * @param const DrawLayer layer
+ * @return void
+ **/
+void World::draw(const DrawLayer layer) {
+
+  ComponentArray<SpriteComponent>& sprites = sprites_[layer];
+  for (unsigned int i = 0; i < sprites.size(); i++){
+    SpriteComponent& sprite = sprites.at(i);
+    if (!sprite.visible_){ continue; }
+    const TransformComponent& transform = transforms_.get(sprites.owner(i));
+    sprite.transform_.x = transform.x_;
+    sprite.transform_.y = transform.y_;
+    sprite.transform_.angle = transform.angle_;
+    RENDERQUEUE.sprite(sprite.handle_, sprite.transform_);
+  }
+
+  // outlines on top of the sprites, only while debugging colliders
+  ComponentArray<ColliderComponent>& colliders = colliders_[layer];
+  float points[(kMaxColliderVerts + 1) * 2];
+  for (unsigned int i = 0; i < colliders.size(); i++){
+    const ColliderComponent& collider = colliders.at(i);
+    if (!collider.visible_ || !collider.outline_){ continue; }
+    const TransformComponent& transform =
+        transforms_.get(colliders.owner(i));
+    const float c = cos(transform.angle_);
+    const float s = sin(transform.angle_);
+    for (unsigned short int v = 0; v < collider.num_verts_; v++){
+      const float x = collider.verts_[v * 2];
+      const float y = collider.verts_[v * 2 + 1];
+      points[v * 2] = transform.x_ + c * x - s * y;
+      points[v * 2 + 1] = transform.y_ + s * x + c * y;
+    }
+
+    if (collider.closed_){
+      points[collider.num_verts_ * 2] = points[0];
+      points[collider.num_verts_ * 2 + 1] = points[1];
+      RENDERQUEUE.path(points, collider.num_verts_ + 1, collider.color_,
+                       collider.alpha_, 0);
+    }
+    else {
+      RENDERQUEUE.line(points[0], points[1], points[2], points[3],
+                       collider.color_, collider.alpha_);
+    }
+  }
+}
+
+/** getters **/
+const unsigned int World::numEntities() {
+
+  return alive_;
+}
+
+const unsigned int World::numSprites() {
+
+  unsigned int count = 0;
+  for (unsigned short int i = 0; i < kDrawLayer_Count; i++){
+    count += sprites_[i].size();
+  }
+
+  return count;
+}
+
+/// destructor
+World::~World() {}
@@ -0,0 +1,206 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ECS Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __ECS_H__
+#define __ECS_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include <ESAT/sprite.h>
+
+#define WIN32
+#include "chipmunk_alloc.h"
+#include <ESAT_extra/chipmunk/chipmunk.h>
+
+#include "render_queue.h"
+#include "job_system.h"
+
+#define WORLD World::instance()
+
+/// an index shared by every component array, ids are reused
+typedef unsigned int Entity;
+static const Entity kNoEntity = 0xFFFFFFFF;
+static const unsigned int kNoComponent = 0xFFFFFFFF;
+
+static const unsigned short int kMaxColliderVerts = 16;
+
+/// drawn back to front, every layer keeps its sprites and colliders apart
+static enum DrawLayer {
+  kDrawLayer_Scenario = 0,
+  kDrawLayer_Bricks,
+  kDrawLayer_Bar,
+  kDrawLayer_Ball,
+  kDrawLayer_Count
+};
+
+/** components **/
+/// where the entity is drawn, copied from its body after every step
+struct TransformComponent {
+  float x_;
+  float y_;
+  float angle_;
+};
+
+struct PhysicsComponent {
+  cpBody* body_; // owned by the GameObject2D of the entity
+};
+
+struct SpriteComponent {
+  ESAT::SpriteHandle handle_; // holds a reference, destroy() drops it
+  ESAT::SpriteTransform transform_; // pivot and scale, the rest is synced
+  bool visible_;
+};
+
+/// the shape outline, in body space
+struct ColliderComponent {
+  float verts_[kMaxColliderVerts * 2];
+  unsigned short int num_verts_;
+  float width_; // bounds of verts_
+  float height_;
+  unsigned char color_[3];
+  unsigned char alpha_;
+  bool closed_; // polygons, segments stay open
+  bool outline_; // debug colliders, segments are always drawn
+  bool visible_;
+};
+
+struct TagComponent {
+  unsigned short int tag_; // also the chipmunk collision type
+};
+
+/**
+ * components of one kind packed together, whatever entity owns them;
+ * removing swaps the last one in, so the order is not kept
+ **/
+template<class T>
+class ComponentArray {
+
+  public:
+
+    /// value initialized, an entity has one component of each kind at most
+    T& add(const Entity entity) {
+      if (entity >= sparse_.size()){
+        sparse_.resize(entity + 1, kNoComponent);
+      }
+      if (sparse_[entity] != kNoComponent){ return dense_[sparse_[entity]]; }
+      sparse_[entity] = (unsigned int)dense_.size();
+      dense_.push_back(T());
+      owners_.push_back(entity);
+      return dense_.back();
+    }
+
+    void remove(const Entity entity) {
+      if (!has(entity)){ return; }
+      const unsigned int index = sparse_[entity];
+      const unsigned int last = (unsigned int)dense_.size() - 1;
+      dense_[index] = dense_[last];
+      owners_[index] = owners_[last];
+      sparse_[owners_[index]] = index;
+      dense_.pop_back();
+      owners_.pop_back();
+      sparse_[entity] = kNoComponent;
+    }
+
+    /// keeps adding up to count from allocating
+    void reserve(const unsigned int count) {
+      dense_.reserve(count);
+      owners_.reserve(count);
+      sparse_.reserve(count);
+    }
+
+    /** getters **/
+    const bool has(const Entity entity) {
+      return entity < sparse_.size() && sparse_[entity] != kNoComponent;
+    }
+    T& get(const Entity entity) { return dense_[sparse_[entity]]; }
+    const unsigned int size() { return (unsigned int)dense_.size(); }
+    T& at(const unsigned int index) { return dense_[index]; }
+    const Entity owner(const unsigned int index) { return owners_[index]; }
+
+  private:
+
+    /// private vars
+    std::vector<T> dense_;
+    std::vector<Entity> owners_; // entity of every dense_ component
+    std::vector<unsigned int> sparse_; // dense_ index of every entity
+};
+
+class World {
+
+  public:
+
+    /// singleton
+    static World& instance();
+
+    /**
+     * @brief a new entity, with no components
+     * @param none
+     * @return Entity
+     **/
+    Entity create();
+
+    /// remove every component of the entity, its id is reused after
+    void destroy(const Entity entity);
+
+    /// keeps up to count entities drawn on a layer from allocating
+    void reserve(const unsigned int count, const DrawLayer layer);
+
+    /**
+     * @brief copy every body position and angle into its transform,
+     *        spread on the job system
+     * @param none
+     * @return void
+     **/
+    void syncTransforms();
+
+    /**
+     * @brief sync a range of physics components
+     * @param const unsigned int first, const unsigned int last (excluded)
+     * @return void
+     **/
+    void syncRange(const unsigned int first, const unsigned int last);
+
+    /**
+     * @brief record the sprites and colliders of a layer into the render
+     *        queue, as last synced; only that layer's arrays are walked
+     * @param const DrawLayer layer
+     * @return void
+     **/
+    void draw(const DrawLayer layer);
+
+    /** getters **/
+    const unsigned int numEntities();
+    const unsigned int numSprites(); // of every layer
+
+    /// public vars
+    ComponentArray<TransformComponent> transforms_;
+    ComponentArray<PhysicsComponent> physics_;
+    ComponentArray<SpriteComponent> sprites_[kDrawLayer_Count];
+    ComponentArray<ColliderComponent> colliders_[kDrawLayer_Count];
+    ComponentArray<TagComponent> tags_;
+
+  private:
+
+    /// constructor & destructor
+    World();
+    ~World();
+
+    /// copy constructor
+    World(const World& copy);
+    World operator=(const World& copy);
+
+    /// private vars
+    std::vector<Entity> free_; // destroyed ids
+    Entity next_;
+    unsigned int alive_;
+};
+
+#endif
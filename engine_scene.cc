@@ -10,103 +10,252 @@
 #include "game_manager.h"
 #include "audio_manager.h"
 
-/// collision handler
-cpBool Collision(cpArbiter *arbiter, cpSpace *space, void *data) {
+#ifdef _WIN32
+#include <direct.h>
+#define MakeDirectory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define MakeDirectory(path) mkdir(path, 0755)
+#endif
+
+/// queue a collision event, counting the ones that do not fit
+void PushEvent(GameState* game_state, const CollisionEvent& event) {
+
+  if (!game_state->events_.push(event)){ game_state->dropped_events_++; }
+}
 
-  cpShape* a = NULL;
-  cpShape* b = NULL;
-  GameState* game_state = (GameState*)data;
+/// build a collision event from the contact data of an arbiter
+CollisionEvent ArbiterEvent(cpArbiter* arbiter,
+                            const CollisionEventKind kind) {
+
+  CP_ARBITER_GET_SHAPES(arbiter, a, b);
+  cpVect point = cpArbiterGetPointA(arbiter, 0);
+  cpVect normal = cpArbiterGetNormal(arbiter);
+  cpVect impulse = cpArbiterTotalImpulse(arbiter);
+
+  CollisionEvent event;
+  event.kind_ = kind;
+  event.type_a_ = cpShapeGetCollisionType(a);
+  event.type_b_ = cpShapeGetCollisionType(b);
+  event.brick_ = 0;
+  event.ball_ = (GameObject2D*)cpShapeGetUserData(a);
+  event.point_ = { point.x, point.y, 1.0f };
+  event.normal_ = { normal.x, normal.y, 0.0f };
+  event.impulse_ = sqrt(impulse.x * impulse.x + impulse.y * impulse.y);
+
+  return event;
+}
 
-  cpArbiterGetShapes(arbiter, &a, &b);
+/// take a dead brick out of the space once the step is over
+void RemoveBrick(cpSpace* space, void* key, void* data) {
 
-  /*
-  */
-  printf("COLLISION %d %d\n",
-         cpShapeGetCollisionType(a),
-         cpShapeGetCollisionType(b));
+  GameObject2D* handle = (GameObject2D*)key;
+  handle->set_simulated(false);
+}
 
-  // brick collision
-  for (unsigned short int i = 0; i < game_state->bricks_amount_; i++){
-    if (game_state->bricks_[i].handle_->tag() == cpShapeGetCollisionType(a) ||
-        game_state->bricks_[i].handle_->tag() == cpShapeGetCollisionType(b)){
+/// brick hit, shared by the chipmunk handler and the grid sweep
+const bool HitBrick(GameState* game_state, unsigned short int index) {
 
-      if (game_state->bricks_[i].type_ == 2){
-        game_state->bricks_[i].handle_->set_sprite(
-            "data/assets/sprites/brick8.png");
-      }
-      game_state->bricks_[i].type_--;
-      if (game_state->bricks_[i].type_ < 1){
-        game_state->bricks_[i].must_die_ = true;
-      }
-      game_state->updating_ = 1;
-      return cpTrue;
+  Brick* brick = &game_state->bricks_[index];
+
+  // a dying brick can still be touched again before the step ends
+  if (!brick->is_active_ || brick->must_die_){ return false; }
+
+  if (brick->type_ == 2){
+    brick->handle_->set_sprite("data/assets/sprites/brick8.png");
+  }
+  brick->type_--;
+  if (brick->type_ < 1){
+    brick->must_die_ = true;
+    game_state->dying_.push_back(index);
+    game_state->brick_grid_.set_cell(brick->col_, brick->row_,
+                                     BrickGrid::kEmpty);
+
+    // the space is locked during the step, removal must wait for its end
+    if (brick->handle_->simulated()){
+      cpSpaceAddPostStepCallback(game_state->space_, RemoveBrick,
+                                 brick->handle_, game_state);
     }
   }
 
-  // limit collision
-  if (cpShapeGetCollisionType(a) == LIMIT_TAG ||
-      cpShapeGetCollisionType(b) == LIMIT_TAG){
+  return true;
+}
 
-    if (!game_state->godmode_){ game_state->updating_ = 2; }
-    return cpTrue;
-  }
+/**
+ * @brief ball collision handlers, one per collision type pair, specialized
+ *        at compile time (the ball is always shape a, the other one b).
+ *        They run after the contact is solved, once per new contact, so
+ *        the queued event carries the real impulse
+ * @param cpArbiter* arbiter, cpSpace* space, void* data
+ * @return void
+ **/
+template <cpCollisionType kOtherTag>
+void BallCollision(cpArbiter* arbiter, cpSpace* space, void* data) {
 
   // wall collision && bar center collision
-  if (cpShapeGetCollisionType(a) == WALL_TAG ||
-      cpShapeGetCollisionType(a) == CBAR_TAG ||
-      cpShapeGetCollisionType(b) == WALL_TAG ||
-      cpShapeGetCollisionType(b) == CBAR_TAG){
+  if (!cpArbiterIsFirstContact(arbiter)){ return; }
+  PushEvent((GameState*)data, ArbiterEvent(arbiter, kCollisionEvent_Bounce));
+}
 
-    game_state->updating_ = 3;
-    return cpTrue;
-  }
+/// brick collision
+template <>
+void BallCollision<BRICK_TAG>(cpArbiter* arbiter,
+                              cpSpace* space,
+                              void* data) {
 
-  // bar border collision
-  if (cpShapeGetCollisionType(a) == LBAR_TAG ||
-      cpShapeGetCollisionType(b) == LBAR_TAG){
+  if (!cpArbiterIsFirstContact(arbiter)){ return; }
 
-    game_state->updating_ = 4;
-    return cpTrue;
-  }
-  else if (cpShapeGetCollisionType(a) == RBAR_TAG ||
-           cpShapeGetCollisionType(b) == RBAR_TAG){
+  CP_ARBITER_GET_SHAPES(arbiter, ball, brick);
+  GameState* game_state = (GameState*)data;
+  CollisionEvent event = ArbiterEvent(arbiter, kCollisionEvent_Score);
+  event.brick_ = (unsigned short int)(uintptr_t)cpShapeGetUserData(brick);
 
-    game_state->updating_ = 5;
-    return cpTrue;
-  }
+  if (HitBrick(game_state, event.brick_)){ PushEvent(game_state, event); }
+}
 
-  /*
-  // powerup collision
-  if (cpShapeGetCollisionType(a) == POWERUP_TAG){ game_state->updating_ = 6; }
-  else if (cpShapeGetCollisionType(b) == POWERUP_TAG){
-    game_state->updating_ = 6;
-  }
-  */
+/// limit collision
+template <>
+void BallCollision<LIMIT_TAG>(cpArbiter* arbiter,
+                              cpSpace* space,
+                              void* data) {
+
+  GameState* game_state = (GameState*)data;
+  if (!cpArbiterIsFirstContact(arbiter) || game_state->godmode_){ return; }
+  PushEvent(game_state, ArbiterEvent(arbiter, kCollisionEvent_Die));
+}
+
+/// bar border collision
+template <>
+void BallCollision<LBAR_TAG>(cpArbiter* arbiter,
+                             cpSpace* space,
+                             void* data) {
+
+  if (!cpArbiterIsFirstContact(arbiter)){ return; }
+  PushEvent((GameState*)data,
+            ArbiterEvent(arbiter, kCollisionEvent_BounceLeft));
+}
+
+template <>
+void BallCollision<RBAR_TAG>(cpArbiter* arbiter,
+                             cpSpace* space,
+                             void* data) {
+
+  if (!cpArbiterIsFirstContact(arbiter)){ return; }
+  PushEvent((GameState*)data,
+            ArbiterEvent(arbiter, kCollisionEvent_BounceRight));
+}
+
+/// register the handler of the ball against a collision type
+template <cpCollisionType kOtherTag>
+void AddBallHandler(cpSpace* space, GameState* game_state) {
 
-  return cpFalse;
+  cpCollisionHandler* handler = cpSpaceAddCollisionHandler(space,
+                                                           BALL_TAG,
+                                                           kOtherTag);
+  handler->postSolveFunc = BallCollision<kOtherTag>;
+  handler->userData = game_state;
+}
+
+/**
+ * @brief debug widgets bound to a body, a setter only runs on the frame
+ *        its widget was edited
+ * @param GameObject2D* object, const unsigned short int fields (BodyField)
+ * @return void
+ **/
+void EditBody(GameObject2D* object, const unsigned short int fields) {
+
+  if (fields & kBodyField_Position){
+    gtmath::Vec3 position = object->position();
+    if (ImGui::DragFloat2("Position", &position.x)){
+      object->set_position(position);
+    }
+  }
+  if (fields & kBodyField_Velocity){
+    gtmath::Vec3 velocity = object->velocity();
+    if (ImGui::DragFloat2("Velocity", &velocity.x)){
+      object->set_velocity(velocity);
+    }
+  }
+  if (fields & kBodyField_Angle){
+    float angle = object->angle();
+    if (ImGui::SliderFloat("Angle", &angle, -(kPid / 2), (kPid / 2))){
+      object->set_angle(angle);
+    }
+  }
+  if (fields & kBodyField_Mass){
+    float mass = object->mass();
+    if (ImGui::SliderFloat("Mass", &mass, 0.1f, 20.0f)){
+      object->set_mass(mass);
+    }
+  }
+  if (fields & kBodyField_Friction){
+    float friction = object->friction();
+    if (ImGui::SliderFloat("Friction", &friction, 0.0f, 1.0f)){
+      object->set_friction(friction);
+    }
+  }
+  if (fields & kBodyField_Elasticity){
+    float elasticity = object->elasticity();
+    if (ImGui::SliderFloat("Elasticity", &elasticity, 0.0f, 1.0f)){
+      object->set_elasticity(elasticity);
+    }
+  }
+  if (fields & kBodyField_Moment){
+    bool infinity = object->infinity();
+    if (ImGui::Checkbox("Infinity", &infinity)){
+      object->set_infinity(infinity);
+    }
+    if (!infinity){
+      float moment = object->moment();
+      if (ImGui::SliderFloat("Moment", &moment, 0.0f, 1.0f)){
+        object->set_moment(moment);
+      }
+    }
+  }
 }
 
 /// constructor
 EngineScene::EngineScene() {
 
   game_state_.space_ = cpSpaceNew();
-  game_state_.cbar_ = new GameObject2D();
-  game_state_.lbar_ = new GameObject2D();
-  game_state_.rbar_ = new GameObject2D();
-  game_state_.ball_ = new GameObject2D();
+  if (!ChipmunkAllocHooked()){
+    fprintf(stderr, "Error: chipmunk was built without chipmunk_alloc.h "
+                    "forced in, physics allocations are not counted\n");
+  }
+  game_state_.cbar_ = new GameObject2D(kDrawLayer_Bar);
+  game_state_.lbar_ = new GameObject2D(kDrawLayer_Bar);
+  game_state_.rbar_ = new GameObject2D(kDrawLayer_Bar);
+  game_state_.ball_ = new GameObject2D(kDrawLayer_Ball);
   for (unsigned short int i = 0; i < 4; i++){
-    game_state_.walls_[i] = new GameObject2D();
+    game_state_.walls_[i] = new GameObject2D(kDrawLayer_Scenario);
   }
+  WORLD.reserve(kGridCols * kGridRows + 8, kDrawLayer_Bricks);
+  game_state_.level_arena_.init(kLevelArenaSize);
   game_state_.bricks_amount_ = 0;
-  game_state_.updating_ = 0;
+  game_state_.level_cols_ = 0;
+  game_state_.level_rows_ = 0;
+  game_state_.brick_scale_ = 1.0f;
+  game_state_.dropped_events_ = 0;
+  game_state_.capped_substeps_ = 0;
+  game_state_.dying_.reserve(kMaxLevelBricks);
   game_state_.godmode_ = false;
   game_state_.freemode_ = false;
   game_state_.drawcolliders_ = false;
+  game_state_.analytic_bricks_ = false;
+  game_state_.ccd_ = false;
   game_status_ = kGameStatus_None;
   gamepad_ = nullptr;
+  last_pad_time_ = 0.0;
+  input_sequence_ = 0;
   lua_ = nullptr;
-  level_ = new Text();
-  score_ = new Text();
+  particles_ = new ParticleSystem();
+  for (unsigned short int i = 0; i < kNumBrickSprites; i++){
+    brick_sprites_[i] = NULL;
+  }
+  level_ = new HUDCounter();
+  score_ = new HUDCounter();
+  total_score_ = new HUDCounter();
+  game_over_ = new Text();
   life_ = new Sprite();
   bar_velocity_ = { 0.0f, 0.0f, 0.0f };
   total_levels_ = 0;
@@ -118,7 +267,10 @@ EngineScene::EngineScene() {
   bar_speed_ = 0.0f;
   bar_friction_ = 0.0f;
   ball_speed_ = 0.0f;
+  editor_kind_ = 1;
+  editor_spec_ = LevelSpecForBricks(1000, 42, kLevelPattern_Noise);
   is_joint_ = false;
+  is_painting_ = false;
 }
 
 /** settings **/
@@ -134,6 +286,7 @@ void EngineScene::initMap() {
   game_state_.walls_[0]->set_elasticity(
       lua_->getNumberFromTable("wall_settings", "elasticity"));
   game_state_.walls_[0]->set_tag(WALL_TAG);
+  game_state_.walls_[0]->set_filter(WALL_CATEGORY, BALL_CATEGORY);
 
   game_state_.walls_[1]->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
   game_state_.walls_[1]->addBodyBox(
@@ -144,6 +297,7 @@ void EngineScene::initMap() {
   game_state_.walls_[1]->set_elasticity(
       lua_->getNumberFromTable("wall_settings", "elasticity"));
   game_state_.walls_[1]->set_tag(LIMIT_TAG);
+  game_state_.walls_[1]->set_filter(WALL_CATEGORY, BALL_CATEGORY);
 
   game_state_.walls_[2]->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
   game_state_.walls_[2]->addBodyBox(
@@ -154,6 +308,7 @@ void EngineScene::initMap() {
   game_state_.walls_[2]->set_elasticity(
       lua_->getNumberFromTable("wall_settings", "elasticity"));
   game_state_.walls_[2]->set_tag(WALL_TAG);
+  game_state_.walls_[2]->set_filter(WALL_CATEGORY, BALL_CATEGORY);
 
   game_state_.walls_[3]->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
   game_state_.walls_[3]->addBodyBox(
@@ -164,6 +319,7 @@ void EngineScene::initMap() {
   game_state_.walls_[3]->set_elasticity(
       lua_->getNumberFromTable("wall_settings", "elasticity"));
   game_state_.walls_[3]->set_tag(WALL_TAG);
+  game_state_.walls_[3]->set_filter(WALL_CATEGORY, BALL_CATEGORY);
 
   // bar center
   game_state_.cbar_->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
@@ -179,6 +335,7 @@ void EngineScene::initMap() {
   game_state_.cbar_->set_infinity(
       lua_->getBooleanFromTable("bar_settings", "infinity"));
   game_state_.cbar_->set_tag(CBAR_TAG);
+  game_state_.cbar_->set_filter(BAR_CATEGORY, BALL_CATEGORY);
 
   // bar border left
   game_state_.lbar_->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
@@ -194,6 +351,7 @@ void EngineScene::initMap() {
   game_state_.lbar_->set_infinity(
       lua_->getBooleanFromTable("bar_settings", "infinity"));
   game_state_.lbar_->set_tag(LBAR_TAG);
+  game_state_.lbar_->set_filter(BAR_CATEGORY, BALL_CATEGORY);
 
   // bar border right
   game_state_.rbar_->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
@@ -209,6 +367,7 @@ void EngineScene::initMap() {
   game_state_.rbar_->set_infinity(
       lua_->getBooleanFromTable("bar_settings", "infinity"));
   game_state_.rbar_->set_tag(RBAR_TAG);
+  game_state_.rbar_->set_filter(BAR_CATEGORY, BALL_CATEGORY);
 
   bar_max_speed_ = lua_->getNumberFromTable("bar_settings", "max_speed");
   bar_sprint_max_speed_ = lua_->getNumberFromTable("bar_settings",
@@ -216,9 +375,28 @@ void EngineScene::initMap() {
   bar_friction_ = lua_->getNumberFromTable("bar_settings", "air_friction");
 
   // ball
-  game_state_.ball_->init(game_state_.space_);
+  initBall(game_state_.ball_);
+
+  ball_speed_ = lua_->getNumberFromTable("ball_settings", "speed");
+
+  game_state_.analytic_bricks_ = lua_->getBooleanFromTable("brick_settings",
+                                                           "analytic");
+  game_state_.ccd_ = lua_->getBooleanFromTable("ball_settings", "ccd");
+
+  // settings
+  total_levels_ = lua_->getGlobalNumber("kTotalLevels");
+  current_level_ = 1;
+  lifes_amount_ = 3;
+  is_joint_ = true;
+  game_status_ = kGameStatus_Start;
+}
+
+/// body and sprite of a ball, at the start position
+void EngineScene::initBall(GameObject2D* ball) {
+
+  ball->init(game_state_.space_);
   #if 1 // instantiate as a box
-  game_state_.ball_->addBodyBox(
+  ball->addBodyBox(
       "data/assets/sprites/ball.png",
       { lua_->getNumberFromTable("ball_settings", "x"),
         lua_->getNumberFromTable("ball_settings", "y"),
@@ -226,7 +404,7 @@ void EngineScene::initMap() {
       lua_->getNumberFromTable("ball_settings", "mass"),
       lua_->getNumberFromTable("ball_settings", "friction"));
   #else // instantiate as a circle
-  game_state_.ball_->addBodyCircle(
+  ball->addBodyCircle(
     "data/assets/sprites/ball.png",
     100,
     10.0f,
@@ -236,88 +414,365 @@ void EngineScene::initMap() {
     lua_->getNumberFromTable("ball_settings", "mass"),
     lua_->getNumberFromTable("ball_settings", "friction"));
   #endif
-  game_state_.ball_->set_elasticity(
+  ball->set_elasticity(
       lua_->getNumberFromTable("ball_settings", "elasticity"));
-  game_state_.ball_->set_infinity(
+  ball->set_infinity(
       lua_->getBooleanFromTable("ball_settings", "infinity"));
-  game_state_.ball_->set_tag(BALL_TAG);
+  ball->set_tag(BALL_TAG);
+  ball->set_filter(BALL_CATEGORY, CP_ALL_CATEGORIES);
+  // events tell which ball was hit through it
+  ball->set_userData(ball);
+}
 
-  ball_speed_ = lua_->getNumberFromTable("ball_settings", "speed");
+/**
+ * @brief one more ball, launched from the start position; extra balls
+ *        score and bounce like the first one but never cost a life
+ * @param none
+ * @return void
+ **/
+void EngineScene::addBall() {
 
-  // settings
-  total_levels_ = lua_->getGlobalNumber("kTotalLevels");
-  current_level_ = 1;
-  lifes_amount_ = 3;
-  is_joint_ = true;
-  game_status_ = kGameStatus_Start;
+  GameObject2D* ball = new GameObject2D(kDrawLayer_Ball);
+  initBall(ball);
+  launchBall(ball, (unsigned int)game_state_.balls_.size());
+  game_state_.balls_.push_back(ball);
+}
+
+/// delete every extra ball
+void EngineScene::removeBalls() {
+
+  for (unsigned int i = 0; i < game_state_.balls_.size(); i++){
+    delete game_state_.balls_[i];
+  }
+  game_state_.balls_.clear();
+}
+
+/**
+ * @brief put an extra ball back at the start, going up to one side
+ * @param GameObject2D* ball, const unsigned int index (picks the side)
+ * @return void
+ **/
+void EngineScene::launchBall(GameObject2D* ball, const unsigned int index) {
+
+  const float side = index % 2 == 0 ? -1.0f : 1.0f;
+
+  teleportObject(ball,
+                 { lua_->getNumberFromTable("ball_settings", "x"),
+                   lua_->getNumberFromTable("ball_settings", "y"),
+                   1.0f },
+                 true);
+  ball->set_velocity((gtmath::Vec3Right() * side - gtmath::Vec3Up()) *
+                     ball_speed_);
 }
 
 void EngineScene::initTexts() {
 
-  level_->init("LEVEL 1\0", { 450.0f, 60.0f });
-  score_->init("SCORE 0\0", { 620.0f, 60.0f });
+  level_->init("LEVEL ", 1, { 450.0f, 60.0f });
+  score_->init("SCORE ", 0, { 620.0f, 60.0f });
+  total_score_->init("TOTAL SCORE ", 0, { 296.0f, 460.0f });
+  game_over_->init("GAME OVER", { 268.0f, 420.0f }, 50);
 }
 
 void EngineScene::initSprites() {
 
   life_->init("data/assets/sprites/bar.png");
   life_->set_scale({ 0.5f, 0.5f, 1.0f });
+
+  // bricks swap sprites from the simulation, keep every kind loaded
+  for (unsigned short int i = 0; i < kNumBrickSprites; i++){
+    char path[64];
+    snprintf(path, 64, "data/assets/sprites/brick%d.png", i + 1);
+    brick_sprites_[i] = Sprite::Acquire(path);
+  }
 }
 
 void EngineScene::initBrick(unsigned short int index,
-                            unsigned short int x,
-                            unsigned short int y,
+                            const float x,
+                            const float y,
                             unsigned short int kind) {
 
-  game_state_.bricks_[index].handle_ = new GameObject2D();
-  game_state_.bricks_[index].handle_->init(game_state_.space_,
-                                           1.0f,
-                                           1.0f,
-                                           kBodyKind_Kinematic);
-  std::string buffer;
-  buffer = "data/assets/sprites/brick" + std::to_string(kind) + ".png";
-  game_state_.bricks_[index].handle_->addBodyBox(
-      buffer.c_str(),
+  char path[64];
+  snprintf(path, 64, "data/assets/sprites/brick%d.png", kind);
+
+  Brick* brick = &game_state_.bricks_[index];
+
+  // the handle lives in the arena, what is drawn in the world components
+  Arena* arena = &game_state_.level_arena_;
+  brick->handle_ = arena->create<GameObject2D>(kDrawLayer_Bricks);
+  brick->handle_->init(game_state_.space_, 1.0f, 1.0f, kBodyKind_Kinematic);
+  brick->handle_->addBodyBox(
+      path,
       { x, y, 1.0f },
       lua_->getNumberFromTable("brick_settings", "mass"),
-      lua_->getNumberFromTable("brick_settings", "friction"));
-  game_state_.bricks_[index].handle_->set_elasticity(
+      lua_->getNumberFromTable("brick_settings", "friction"),
+      1.0f,
+      game_state_.brick_scale_);
+  brick->handle_->set_elasticity(
       lua_->getNumberFromTable("brick_settings", "elasticity"));
-  if (kind == 7){ game_state_.bricks_[index].type_ = 2; }
-  else { game_state_.bricks_[index].type_ = 1; }
-  game_state_.bricks_[index].is_active_ = true;
-  game_state_.bricks_[index].must_die_ = false;
-  game_state_.bricks_[index].handle_->set_tag(index + 10);
+  brick->handle_->set_tag(BRICK_TAG);
+  brick->handle_->set_filter(BRICK_CATEGORY, BALL_CATEGORY);
+  brick->handle_->set_userData((void*)(uintptr_t)index);
+  if (kind == 7){ brick->type_ = 2; }
+  else { brick->type_ = 1; }
+  brick->kind_ = kind;
+  brick->is_active_ = true;
+  brick->must_die_ = false;
+  brick->handle_->drawCollider(game_state_.drawcolliders_);
+
+  // the grid sweep owns ball vs brick, keep bricks out of the broadphase
+  if (game_state_.analytic_bricks_){ brick->handle_->set_simulated(false); }
+}
+
+/**
+ * @brief take a brick out of the space and the world, so nothing walks it
+ *        anymore; the arena frees the empty object with the level
+ * @param unsigned short int index
+ * @return void
+ **/
+void EngineScene::killBrick(unsigned short int index) {
+
+  Brick* brick = &game_state_.bricks_[index];
+
+  if (brick->handle_ == nullptr){ return; }
+
+  brick->handle_->destroy();
+  game_state_.brick_grid_.set_cell(brick->col_, brick->row_,
+                                   BrickGrid::kEmpty);
+  brick->handle_ = nullptr;
+  brick->is_active_ = false;
+  brick->must_die_ = false;
 }
 
 void EngineScene::levelDump(unsigned short int level) {
 
-  std::string buffer;
-  buffer = "level" + std::to_string(level);
-  set_levelNum(lua_->getIntegerFromTableByIndex(buffer.c_str(), 0));
-  game_state_.bricks_amount_ = lua_->getIntegerFromTableByIndex(
-      buffer.c_str(), 1);
-
-  std::vector<unsigned short int> grid_;
-  game_state_.bricks_.resize(game_state_.bricks_amount_);
-  for (unsigned short int i = 0; i < kGridCols * kGridRows; i++){
-    grid_.push_back(lua_->getIntegerFromTableByIndex(buffer.c_str(), i + 2));
-  }
-
-  short int index = 0;
-  float x_offset = 170.0f;
-  float y_offset = 200.0f;
-  for (unsigned short int i = 0; i < kGridCols * kGridRows; i++){
-    if (i % kGridCols == 0 && i != 0){
-      x_offset = 170.0f;
-      y_offset += 30.0f;
-    }
-    if (grid_[i] != 0){
-      initBrick(index, x_offset, y_offset, grid_[i]);
-      index++;
+  char table[16];
+  snprintf(table, 16, "level%d", level);
+
+  // a level saved by the editor replaces the table of config.lua
+  char path[64];
+  snprintf(path, 64, kLevelPath, level);
+  lua_->loadFile(path);
+
+  // every read by index leaves the table and the value on the stack
+  set_levelNum(lua_->getIntegerFromTableByIndex(table, 0));
+  lua_->pop(2);
+
+  // saved levels carry their size, the config.lua ones are all 10 x 7
+  int cols = lua_->getIntegerFromTable(table, "cols");
+  int rows = lua_->getIntegerFromTable(table, "rows");
+  if (cols <= 0 || rows <= 0 || cols > 65535 || rows > 65535){
+    cols = kGridCols;
+    rows = kGridRows;
+  }
+  game_state_.level_cols_ = (unsigned short int)cols;
+  game_state_.level_rows_ = (unsigned short int)rows;
+  game_state_.level_cells_.resize((unsigned int)cols * rows);
+  lua_->getIntegersFromTableByIndex(table, 2,
+                                    game_state_.level_cells_.size(),
+                                    &game_state_.level_cells_[0]);
+
+  buildLevel();
+}
+
+/// a brick for every cell of level_cells_, on a fresh grid
+void EngineScene::buildLevel() {
+
+  const unsigned short int cols = game_state_.level_cols_;
+  const unsigned short int rows = game_state_.level_rows_;
+  const std::vector<unsigned short int>& cells = game_state_.level_cells_;
+
+  // the original 10 x 7 levels fit as they are
+  float scale = 1.0f;
+  if (cols * kBrickCellWidth > kLevelWidth){
+    scale = kLevelWidth / (cols * kBrickCellWidth);
+  }
+  if (rows * kBrickCellHeight * scale > kLevelHeight){
+    scale = kLevelHeight / (rows * kBrickCellHeight);
+  }
+  const gtmath::Vec3 cell = { kBrickCellWidth * scale,
+                              kBrickCellHeight * scale,
+                              0.0f };
+  game_state_.brick_scale_ = scale;
+  game_state_.brick_grid_.init(cols, rows,
+                               { kLevelCenterX - (cols - 1) * cell.x / 2,
+                                 kLevelTop,
+                                 1.0f },
+                               cell, cell);
+
+  unsigned int amount = 0;
+  for (unsigned int i = 0; i < cells.size(); i++){
+    if (cells[i] != 0){ amount++; }
+  }
+  if (amount > kMaxLevelBricks){
+    printf("Warning: level with %u bricks, only %u are built\n", amount,
+           kMaxLevelBricks);
+    amount = kMaxLevelBricks;
+  }
+  game_state_.bricks_amount_ = amount;
+  game_state_.bricks_.resize(amount);
+  WORLD.reserve(amount + 8, kDrawLayer_Bricks);
+
+  // a handle and its finalizer per brick, worst case padding included, so
+  // the overflow warning is left for the bricks added in the editor
+  const unsigned int brick_bytes = sizeof(GameObject2D) +
+                                   alignof(GameObject2D) +
+                                   sizeof(ArenaFinalizer) +
+                                   alignof(ArenaFinalizer);
+  game_state_.level_arena_.reserve(amount * brick_bytes);
+
+  unsigned short int index = 0;
+  for (unsigned int i = 0; i < cells.size() && index < amount; i++){
+    if (cells[i] == 0){ continue; }
+    const unsigned short int col = i % cols;
+    const unsigned short int row = i / cols;
+    const gtmath::Vec3 center = game_state_.brick_grid_.cellCenter(col, row);
+    initBrick(index, center.x, center.y, cells[i]);
+    game_state_.bricks_[index].col_ = col;
+    game_state_.bricks_[index].row_ = row;
+    game_state_.brick_grid_.set_cell(col, row, index);
+    index++;
+  }
+
+  // collide against the real brick size, not the cell spacing
+  if (index > 0){
+    game_state_.brick_grid_.set_brickSize(
+        { game_state_.bricks_[0].handle_->width(),
+          game_state_.bricks_[0].handle_->height(),
+          0.0f });
+  }
+}
+
+/**
+ * @brief replace the level with a generated one, built the same way
+ *        levelDump builds the config.lua ones
+ * @param const LevelSpec& spec
+ * @return void
+ **/
+void EngineScene::generateLevel(const LevelSpec& spec) {
+
+  resetBricks();
+
+  game_state_.level_cols_ = spec.cols_;
+  game_state_.level_rows_ = spec.rows_;
+  GenerateLevel(spec, &game_state_.level_cells_);
+
+  buildLevel();
+}
+
+/**
+ * @brief change one cell of the level, only the brick there is touched
+ * @param const unsigned short int col, const unsigned short int row,
+ *        const unsigned short int kind (0 for a gap)
+ * @return void
+ **/
+void EngineScene::editBrick(const unsigned short int col,
+                            const unsigned short int row,
+                            const unsigned short int kind) {
+
+  if (col >= game_state_.level_cols_ || row >= game_state_.level_rows_ ||
+      kind > kNumBrickKinds){
+    return;
+  }
+
+  short int index = game_state_.brick_grid_.cell(col, row);
+
+  // a slot killed by play or erasing is taken before growing the list
+  unsigned int free_slot = game_state_.bricks_amount_;
+  if (kind != 0 && index == BrickGrid::kEmpty){
+    for (unsigned int i = 0; i < game_state_.bricks_amount_; i++){
+      if (game_state_.bricks_[i].handle_ == nullptr){
+        free_slot = i;
+        break;
+      }
     }
-    x_offset += 50.0f;
   }
+
+  // a full level can still be erased and repainted, just not grown
+  if (kind != 0 && index == BrickGrid::kEmpty &&
+      free_slot >= kMaxLevelBricks){
+    return;
+  }
+
+  game_state_.level_cells_[row * game_state_.level_cols_ + col] = kind;
+
+  // erased, the brick leaves like a destroyed one
+  if (kind == 0){
+    if (index != BrickGrid::kEmpty){ killBrick(index); }
+    return;
+  }
+
+  // repainted, same body with another sprite
+  if (index != BrickGrid::kEmpty){
+    Brick* brick = &game_state_.bricks_[index];
+    if (brick->kind_ == kind){ return; }
+    char path[64];
+    snprintf(path, 64, "data/assets/sprites/brick%d.png", kind);
+    brick->handle_->set_sprite(path);
+    brick->type_ = kind == 7 ? 2 : 1;
+    brick->kind_ = kind;
+    return;
+  }
+
+  // painted on a gap, in a free slot or one more at the end of the list
+  const gtmath::Vec3 center = game_state_.brick_grid_.cellCenter(col, row);
+  index = free_slot;
+  if (free_slot == game_state_.bricks_amount_){
+    game_state_.bricks_.resize(index + 1);
+    game_state_.bricks_amount_++;
+  }
+  initBrick(index, center.x, center.y, kind);
+  game_state_.bricks_[index].col_ = col;
+  game_state_.bricks_[index].row_ = row;
+  game_state_.brick_grid_.set_cell(col, row, index);
+  if (index == 0){
+    game_state_.brick_grid_.set_brickSize(
+        { game_state_.bricks_[0].handle_->width(),
+          game_state_.bricks_[0].handle_->height(),
+          0.0f });
+  }
+}
+
+/**
+ * @brief write the level as authored to kLevelPath, in the same table
+ *        format as config.lua plus its cols and rows
+ * @param none
+ * @return const bool
+ **/
+const bool EngineScene::saveLevel() {
+
+  const unsigned short int cols = game_state_.level_cols_;
+  const std::vector<unsigned short int>& cells = game_state_.level_cells_;
+
+  // not in a fresh checkout, it is fine when they are there already
+  MakeDirectory("data");
+  MakeDirectory(kLevelDirectory);
+
+  char path[64];
+  snprintf(path, 64, kLevelPath, current_level_);
+  FILE* file = fopen(path, "w");
+  if (file == NULL){
+    printf("Error: can't write %s\n", path);
+    return false;
+  }
+
+  unsigned int amount = 0;
+  for (unsigned int i = 0; i < cells.size(); i++){
+    if (cells[i] != 0){ amount++; }
+  }
+
+  fprintf(file, "level%d = {\n  %d, %u,\n  cols = %d, rows = %d,",
+          current_level_, current_level_, amount, cols,
+          game_state_.level_rows_);
+  for (unsigned int i = 0; i < cells.size(); i++){
+    fprintf(file, i % cols == 0 ? "\n  %d" : " %d", cells[i]);
+    if (i + 1 < cells.size()){ fprintf(file, ","); }
+  }
+  fprintf(file, "\n};\n");
+  fclose(file);
+
+  printf("level %d saved to %s\n", current_level_, path);
+
+  return true;
 }
 
 /// init values
@@ -327,15 +782,21 @@ void EngineScene::init() {
   lua_ = new LuaWrapper();
   lua_->init("config.lua");
 
+  // audio loads in the background while the level is built
+  AUDIOMANAGER.load(lua_, GAMEMANAGER.headless_ ? SoLoud::Soloud::NULLDRIVER :
+                                                  SoLoud::Soloud::AUTO);
+
   // set chipmunk space
   cpSpaceSetGravity(game_state_.space_, { 0.0f, 0.0f });
   cpSpaceSetDamping(game_state_.space_, 1.0f);
 
-  // register collider listener
-  cpCollisionHandler* handler = cpSpaceAddDefaultCollisionHandler(
-      game_state_.space_);
-  handler->beginFunc = Collision;
-  handler->userData = &game_state_;
+  // register collider listeners, only the pairs the game cares about
+  AddBallHandler<CBAR_TAG>(game_state_.space_, &game_state_);
+  AddBallHandler<LBAR_TAG>(game_state_.space_, &game_state_);
+  AddBallHandler<RBAR_TAG>(game_state_.space_, &game_state_);
+  AddBallHandler<WALL_TAG>(game_state_.space_, &game_state_);
+  AddBallHandler<LIMIT_TAG>(game_state_.space_, &game_state_);
+  AddBallHandler<BRICK_TAG>(game_state_.space_, &game_state_);
 
   // prepare gamepad
   gamepad_ = new Gamepad(0);
@@ -355,11 +816,37 @@ void EngineScene::init() {
 //-------------------------------------------------------------------------//
 //                                  INPUT                                  //
 //-------------------------------------------------------------------------//
+void EngineScene::sampleInput() {
+
+  const ESAT::SpecialKey kKeys[] = {
+    ESAT::kSpecialKey_Left, ESAT::kSpecialKey_Right, ESAT::kSpecialKey_Up,
+    ESAT::kSpecialKey_Down, ESAT::kSpecialKey_Space, ESAT::kSpecialKey_Enter
+  };
+
+  // the gamepad thread stamps its events when they arrive
+  gamepad_->update();
+  const double pad_time = gamepad_->getLastInputTime();
+  if (pad_time != last_pad_time_){
+    input_sequence_ = LATENCY.sample(pad_time);
+    last_pad_time_ = pad_time;
+  }
+
+  // keys come without a timestamp, this poll is the earliest we know
+  for (unsigned short int i = 0; i < sizeof(kKeys) / sizeof(kKeys[0]); i++){
+    if (ESAT::IsSpecialKeyDown(kKeys[i]) || ESAT::IsSpecialKeyUp(kKeys[i])){
+      input_sequence_ = LATENCY.sample(Profiler::Now());
+      break;
+    }
+  }
+}
+
 void EngineScene::input() {
 
   const float kSpeedIncrease = 25.0f;
   const float kFreeModeForce = 300.0f;
 
+  sampleInput();
+
   switch (game_status_){
     case kGameStatus_Start: {
 
@@ -488,62 +975,107 @@ void EngineScene::input() {
   }
 }
 
+/// keeps the bar under the ball and the game going, for headless runs
+void EngineScene::autopilot() {
+
+  const float kFollowGain = 10.0f;
+
+  switch (game_status_){
+    case kGameStatus_Start: {
+      gtmath::Vec3 ball_velocity = (gtmath::Vec3Right() - gtmath::Vec3Up()) *
+                                   ball_speed_;
+      game_state_.ball_->set_velocity(ball_velocity);
+      is_joint_ = false;
+      game_status_ = kGameStatus_Playing;
+    } break;
+    case kGameStatus_Playing: {
+      // every steering decision is the input of a headless frame
+      input_sequence_ = LATENCY.sample(Profiler::Now());
+      float speed = (game_state_.ball_->position().x -
+                     game_state_.cbar_->position().x) * kFollowGain;
+      if (speed > bar_max_speed_){ speed = bar_max_speed_; }
+      if (speed < -bar_max_speed_){ speed = -bar_max_speed_; }
+      bar_velocity_ = gtmath::Vec3Right() * speed;
+      game_state_.cbar_->set_velocity(bar_velocity_);
+    } break;
+    case kGameStatus_Finished: { resetGame(1); } break;
+    default: break;
+  }
+}
+
 //-------------------------------------------------------------------------//
 //                                 UPDATE                                  //
 //-------------------------------------------------------------------------//
 void EngineScene::updateScene() {
 
-  switch (game_state_.updating_) {
-    // score
-    case 1: {
-      unsigned short int sample = (rand() % 3) + 4;
-      AUDIOMANAGER.playFX(sample, 1.0f);
-      for (unsigned short int i = 0; i < game_state_.bricks_.size(); i++){
-        if (game_state_.bricks_[i].must_die_){
-          game_state_.bricks_[i].must_die_ = false;
-          game_state_.bricks_[i].is_active_ = false;
-          game_state_.bricks_[i].handle_->set_position(
-              { game_state_.bricks_[i].handle_->position().x - 1000.0f,
-                game_state_.bricks_[i].handle_->position().y,
-                1.0f });
-          score_amount_ += 100;
+  CollisionEvent event;
+  bool scored = false;
+
+  // drain every event of the last step in one pass
+  while (game_state_.events_.pop(&event)){
+    switch (event.kind_) {
+      // score
+      case kCollisionEvent_Score: {
+        unsigned short int sample = (rand() % 3) + 4;
+        AUDIOMANAGER.playFX(sample, 1.0f);
+        if (game_state_.bricks_[event.brick_].must_die_){
+          particles_->emit(event.point_, gtmath::Vec3Zero(), 48, 180.0f, 0.8f,
+                           game_state_.bricks_[event.brick_].kind_);
         }
-      }
-      set_scoreAmount(score_amount_);
-      game_state_.updating_ = 0;
-    } break;
-    // die
-    case 2: {
-      AUDIOMANAGER.playFX(3, 1.0f);
-      lifes_amount_--;
-      resetLevel();
-      game_state_.updating_ = 0;
-    } break;
-    // bounce
-    case 3: {
-      AUDIOMANAGER.playFX(1, 1.0f);
-      game_state_.updating_ = 0;
-    } break;
-    case 4: {
-      AUDIOMANAGER.playFX(1, 1.0f);
-      game_state_.ball_->set_velocity({ -ball_speed_,
-                                        game_state_.ball_->velocity().y,
-                                        0.0f });
-      game_state_.updating_ = 0;
-    } break;
-    case 5: {
-      AUDIOMANAGER.playFX(1, 1.0f);
-      game_state_.ball_->set_velocity({ ball_speed_,
-                                        game_state_.ball_->velocity().y,
-                                        0.0f });
-      game_state_.updating_ = 0;
-    } break;
-    // powerup
-    case 6: {
-      AUDIOMANAGER.playFX(2, 1.0f);
-      game_state_.updating_ = 0;
-    } break;
+        else {
+          particles_->emit(event.point_, event.normal_, 12, 120.0f, 0.4f,
+                           game_state_.bricks_[event.brick_].kind_);
+        }
+      } break;
+      // die
+      case kCollisionEvent_Die: {
+        particles_->emit(event.point_, gtmath::Vec3Up() * -1.0f, 96, 300.0f,
+                         1.2f, 8);
+        AUDIOMANAGER.playFX(3, 1.0f);
+        if (event.ball_ != game_state_.ball_){
+          launchBall(event.ball_, rand());
+          break;
+        }
+        lifes_amount_--;
+        resetLevel();
+      } break;
+      // bounce
+      case kCollisionEvent_Bounce: {
+        particles_->emit(event.point_, event.normal_, 6, 90.0f, 0.3f, 0);
+        AUDIOMANAGER.playFX(1, 1.0f);
+      } break;
+      case kCollisionEvent_BounceLeft: {
+        particles_->emit(event.point_, event.normal_, 6, 90.0f, 0.3f, 9);
+        AUDIOMANAGER.playFX(1, 1.0f);
+        event.ball_->set_velocity({ -ball_speed_,
+                                    event.ball_->velocity().y,
+                                    0.0f });
+      } break;
+      case kCollisionEvent_BounceRight: {
+        particles_->emit(event.point_, event.normal_, 6, 90.0f, 0.3f, 9);
+        AUDIOMANAGER.playFX(1, 1.0f);
+        event.ball_->set_velocity({ ball_speed_,
+                                    event.ball_->velocity().y,
+                                    0.0f });
+      } break;
+      // powerup
+      case kCollisionEvent_Powerup: {
+        AUDIOMANAGER.playFX(2, 1.0f);
+      } break;
+    }
+  }
+
+  // kills don't depend on the event queue, a full one only loses effects
+  for (unsigned int i = 0; i < game_state_.dying_.size(); i++){
+    const unsigned short int index = game_state_.dying_[i];
+    if (!game_state_.bricks_[index].must_die_){ continue; }
+    killBrick(index);
+    score_amount_ += 100;
+    scored = true;
   }
+  game_state_.dying_.clear();
+
+  if (scored){ set_scoreAmount(score_amount_); }
 }
 
 void EngineScene::updateBar() {
@@ -574,11 +1106,6 @@ void EngineScene::updateBar() {
   game_state_.rbar_->set_position({ game_state_.cbar_->position().x + 30.0f,
                                     game_state_.cbar_->position().y,
                                     1.0f });
-
-  // update
-  if (game_state_.cbar_ != nullptr){ game_state_.cbar_->update(); }
-  if (game_state_.lbar_ != nullptr){ game_state_.lbar_->update(); }
-  if (game_state_.rbar_ != nullptr){ game_state_.rbar_->update(); }
 }
 
 void EngineScene::updateBall() {
@@ -588,46 +1115,221 @@ void EngineScene::updateBall() {
                                       game_state_.ball_->position().y,
                                       1.0f });
   }
+}
+
+/// copy every body into what is drawn, bodies are independent of each other
+void EngineScene::syncObjects() {
 
-  if (game_state_.ball_ != nullptr){ game_state_.ball_->update(); }
+  ProfileScope profile(kProfileSection_Sync);
+
+  WORLD.syncTransforms();
 }
 
-void EngineScene::updateBricks() {
+/**
+ * @brief sweep a ball through the brick grid and bounce it off the
+ *        first bricks it meets during this step
+ * @param GameObject2D* ball, const double delta_time
+ * @return void
+ **/
+void EngineScene::sweepBall(GameObject2D* ball, const double delta_time) {
+
+  const unsigned short int kMaxHits = 4;
+
+  float step = delta_time / 1000.0f;
+  gtmath::Vec3 position = ball->position();
+  gtmath::Vec3 velocity = ball->velocity();
+  gtmath::Vec3 half = { ball->width() / 2, ball->height() / 2, 0.0f };
+  float remaining = 1.0f;
+  GridHit hit;
+
+  for (unsigned short int i = 0; i < kMaxHits; i++){
+    gtmath::Vec3 delta = velocity * (step * remaining);
+    if (!game_state_.brick_grid_.sweep(position, half, delta, &hit)){ break; }
+
+    // move to the contact and reflect on the hit face
+    position = position + delta * hit.toi;
+    if (hit.normal.x != 0.0f){ velocity.x = -velocity.x; }
+    else { velocity.y = -velocity.y; }
+    remaining *= 1.0f - hit.toi;
+
+    CollisionEvent event;
+    event.kind_ = kCollisionEvent_Score;
+    event.type_a_ = BALL_TAG;
+    event.type_b_ = BRICK_TAG;
+    event.brick_ = hit.index;
+    event.ball_ = ball;
+    event.point_ = position;
+    event.normal_ = hit.normal;
+    event.impulse_ = 0.0f;
+
+    if (HitBrick(&game_state_, hit.index)){ PushEvent(&game_state_, event); }
+  }
 
-  for (unsigned short int i = 0; i < game_state_.bricks_amount_; i++){
-    if (game_state_.bricks_[i].handle_ != nullptr){
-      game_state_.bricks_[i].handle_->update();
+  if (remaining < 1.0f){
+    // rewind along the new velocity, so chipmunk integrating the whole step
+    // lands the ball exactly where the swept path ends
+    ball->set_position(position - velocity * (step * (1.0f - remaining)));
+    ball->set_velocity(velocity);
+  }
+}
+
+/**
+ * @brief earliest time of impact of a ball against walls, bar and
+ *        bricks along a step (1 when nothing is hit)
+ * @param GameObject2D* ball, const float step
+ * @return const float
+ **/
+const float EngineScene::ballTimeOfImpact(GameObject2D* ball,
+                                          const float step) {
+
+  gtmath::Vec3 position = ball->position();
+  gtmath::Vec3 velocity = ball->velocity();
+  gtmath::Vec3 half = { ball->width() / 2, ball->height() / 2, 0.0f };
+  float toi = 1.0f;
+  SweepHit hit;
+
+  // walls
+  for (unsigned short int i = 0; i < 4; i++){
+    GameObject2D* wall = game_state_.walls_[i];
+    if (SweepBox(position, half, velocity * step,
+                 wall->position(),
+                 { wall->width() / 2, wall->height() / 2, 0.0f },
+                 &hit) && hit.toi < toi){
+      toi = hit.toi;
+    }
+  }
+
+  // bar pieces, relative to the bar motion (borders follow the center)
+  GameObject2D* bar[3] = { game_state_.cbar_,
+                           game_state_.lbar_,
+                           game_state_.rbar_ };
+  gtmath::Vec3 relative = (velocity - game_state_.cbar_->velocity()) * step;
+  for (unsigned short int i = 0; i < 3; i++){
+    if (SweepBox(position, half, relative,
+                 bar[i]->position(),
+                 { bar[i]->width() / 2, bar[i]->height() / 2, 0.0f },
+                 &hit) && hit.toi < toi){
+      toi = hit.toi;
     }
   }
+
+  // bricks, unless the grid sweep already solved them
+  GridHit grid_hit;
+  if (!game_state_.analytic_bricks_ &&
+      game_state_.brick_grid_.sweep(position, half, velocity * step,
+                                    &grid_hit) && grid_hit.toi < toi){
+    toi = grid_hit.toi;
+  }
+
+  return toi;
+}
+
+/**
+ * @brief step the chipmunk space, sub-stepping around the earliest ball
+ *        time of impact when any ball moves fast enough to tunnel
+ * @param const double delta_time
+ * @return void
+ **/
+void EngineScene::stepSpace(const double delta_time) {
+
+  AllocScope alloc_scope(kAllocTag_Physics);
+
+  const unsigned short int kMaxSubsteps = 16;
+
+  float step = delta_time / 1000.0f;
+
+  if (!game_state_.ccd_){
+    cpSpaceStep(game_state_.space_, step);
+    return;
+  }
+
+  // a ball moving less than its half size per step can not skip a collider;
+  // the substeps are sized for the fastest ball against its own size
+  const float bar_travel =
+      gtmath::MagnitudeVec3(game_state_.cbar_->velocity()) * step;
+  const unsigned int num_balls = game_state_.balls_.size() + 1;
+  float toi = 1.0f;
+  float ratio = 0.0f; // travel / safe, of the ball needing most substeps
+  for (unsigned int i = 0; i < num_balls; i++){
+    GameObject2D* ball = i == 0 ? game_state_.ball_ :
+                                  game_state_.balls_[i - 1];
+    float safe = ball->width() < ball->height() ? ball->width() / 2 :
+                                                  ball->height() / 2;
+    float travel = gtmath::MagnitudeVec3(ball->velocity()) * step +
+                   bar_travel;
+    if (safe <= 0.0f || travel <= safe){ continue; }
+
+    float ball_toi = ballTimeOfImpact(ball, step);
+    if (ball_toi >= 1.0f){ continue; }
+    if (ball_toi < toi){ toi = ball_toi; }
+    if (travel / safe > ratio){ ratio = travel / safe; }
+  }
+
+  if (toi >= 1.0f){
+    cpSpaceStep(game_state_.space_, step);
+    return;
+  }
+
+  // jump to the moment of contact, then let chipmunk resolve it in substeps
+  // short enough that no ball can cross the collider in one of them
+  if (toi > 0.0f){ cpSpaceStep(game_state_.space_, step * toi); }
+
+  // past the cap a substep is longer than safe, count it so it shows up
+  unsigned int substeps = ceil(ratio * (1.0f - toi));
+  if (substeps < 1){ substeps = 1; }
+  if (substeps > kMaxSubsteps){
+    substeps = kMaxSubsteps;
+    game_state_.capped_substeps_++;
+  }
+
+  float substep = step * (1.0f - toi) / substeps;
+  for (unsigned int i = 0; i < substeps; i++){
+    cpSpaceStep(game_state_.space_, substep);
+  }
 }
 
 void EngineScene::update(const double delta_time) {
 
-  // update gamepad
-  gamepad_->update();
+  ProfileScope profile(kProfileSection_Update);
+  AllocScope alloc_scope(kAllocTag_Game);
+
+  // sounds that were waiting for their sample
+  AUDIOMANAGER.update();
 
   // update elements
   updateScene();
   updateBar();
   updateBall();
-  updateBricks();
   checkStatus();
-  showInfo();
+
+  // bricks out of chipmunk, solve them before stepping the space; extra
+  // balls are never held by the bar, they are swept in every status
+  if (game_state_.analytic_bricks_){
+    if (game_status_ == kGameStatus_Playing){
+      sweepBall(game_state_.ball_, delta_time);
+    }
+    for (unsigned int i = 0; i < game_state_.balls_.size(); i++){
+      sweepBall(game_state_.balls_[i], delta_time);
+    }
+  }
+
+  // update particles
+  PROFILER.begin(kProfileSection_ParticlesUpdate);
+  particles_->update(delta_time / 1000.0f);
+  PROFILER.end(kProfileSection_ParticlesUpdate);
 
   // update chipmunk space
-  cpSpaceStep(game_state_.space_, delta_time / 1000.0f);
+  PROFILER.begin(kProfileSection_Physics);
+  stepSpace(delta_time);
+  PROFILER.end(kProfileSection_Physics);
+
+  // what gets drawn is the state after the step
+  syncObjects();
 }
 
 //-------------------------------------------------------------------------//
 //                                 RENDER                                  //
 //-------------------------------------------------------------------------//
-void EngineScene::renderScenario() {
-
-  for(unsigned short int i = 0; i < 4; i++){
-    if (game_state_.walls_[i] != nullptr){ game_state_.walls_[i]->update(); }
-  }
-}
-
 void EngineScene::renderLifes() {
 
   float x_offest = 46.0f;
@@ -641,16 +1343,34 @@ void EngineScene::renderLifes() {
 
 void EngineScene::render() {
 
-  ESAT::DrawBegin();
-  ESAT::DrawClear(0, 0, 0);
+  ProfileScope profile(kProfileSection_Render);
+  AllocScope alloc_scope(kAllocTag_Render);
 
-  renderScenario();
+  // the frame shows every input sampled so far
+  RENDERQUEUE.stamp(input_sequence_);
+
+  // back to front: scenario, bricks, bar and ball
+  for (unsigned short int i = 0; i < kDrawLayer_Count; i++){
+    WORLD.draw((DrawLayer)i);
+  }
+  PROFILER.begin(kProfileSection_ParticlesRender);
+  particles_->render();
+  PROFILER.end(kProfileSection_ParticlesRender);
   renderLifes();
   HUD();
+}
+
+void EngineScene::present() {
+
+  ProfileScope profile(kProfileSection_Draw);
+
+  ESAT::DrawBegin();
+  ESAT::DrawClear(0, 0, 0);
+
+  RENDERQUEUE.execute();
   debug();
 
   ESAT::DrawEnd();
-  ESAT::WindowFrame();
 }
 
 /** GUI **/
@@ -658,41 +1378,13 @@ void EngineScene::HUD() {
 
   level_->render();
   score_->render();
+  showInfo();
 }
 
 void EngineScene::debug() {
 
   if (GAMEMANAGER.debug_mode_){
 
-    // game state get values
-    int level = current_level_;
-    int lifes = lifes_amount_;
-    int bricks = game_state_.bricks_amount_;
-
-    // space get values
-    gtmath::Point space_gravity = { cpSpaceGetGravity(game_state_.space_).x,
-                                    cpSpaceGetGravity(game_state_.space_).y };
-    float space_damping = cpSpaceGetDamping(game_state_.space_);
-
-    // bar get values
-    gtmath::Vec3 bar_position = game_state_.cbar_->position();
-    gtmath::Vec3 bar_velocity = game_state_.cbar_->velocity();
-    float bar_angle = game_state_.cbar_->angle();
-    float bar_friction = game_state_.cbar_->friction();
-    float bar_elasticity = game_state_.cbar_->elasticity();
-    float bar_moment = game_state_.cbar_->moment();
-    bool bar_infinity = game_state_.cbar_->infinity();
-
-    // ball get values
-    gtmath::Vec3 ball_position = game_state_.ball_->position();
-    gtmath::Vec3 ball_velocity = game_state_.ball_->velocity();
-    float ball_angle = game_state_.ball_->angle();
-    float ball_mass = game_state_.ball_->mass();
-    float ball_friction = game_state_.ball_->friction();
-    float ball_elasticity = game_state_.ball_->elasticity();
-    float ball_moment = game_state_.ball_->moment();
-    bool ball_infinity = game_state_.ball_->infinity();
-
     // imgui interface
     ImGui::Begin("Debug Window");
     ImGui::Text("Debugger for Arkanoid");
@@ -700,113 +1392,147 @@ void EngineScene::debug() {
     ImGui::Text("Mouse Position: (%g, %g)", io.MousePos.x, io.MousePos.y);
     // game info
     if (ImGui::CollapsingHeader("Game State")){
-      bool godmode = game_state_.godmode_;
-      ImGui::Checkbox("God Mode", &godmode);
-      game_state_.godmode_ = godmode;
+      ImGui::Checkbox("God Mode", &game_state_.godmode_);
       ImGui::SameLine();
-      bool freemode = game_state_.freemode_;
-      ImGui::Checkbox("Free Mode", &freemode);
-      game_state_.freemode_ = freemode;
+      ImGui::Checkbox("Free Mode", &game_state_.freemode_);
       ImGui::SameLine();
-      bool colliders = game_state_.drawcolliders_;
-      ImGui::Checkbox("Draw Colliders", &colliders);
-      game_state_.drawcolliders_ = colliders;
-      ImGui::InputInt("Lifes", &lifes);
+      if (ImGui::Checkbox("Draw Colliders", &game_state_.drawcolliders_)){
+        drawColliders(game_state_.drawcolliders_);
+      }
+      ImGui::Checkbox("Ball CCD", &game_state_.ccd_);
+      int lifes = lifes_amount_;
+      if (ImGui::InputInt("Lifes", &lifes)){ lifes_amount_ = lifes; }
     }
     // space info
     if (ImGui::CollapsingHeader("Space Settings")){
-      ImGui::DragFloat2("Space Gravity", &space_gravity.x);
-      ImGui::SliderFloat("Space Damping", &space_damping, 0.0f, 1.0f);
+      cpVect gravity = cpSpaceGetGravity(game_state_.space_);
+      float space_gravity[2] = { (float)gravity.x, (float)gravity.y };
+      if (ImGui::DragFloat2("Space Gravity", space_gravity)){
+        cpSpaceSetGravity(game_state_.space_,
+                          { space_gravity[0], space_gravity[1] });
+      }
+      float space_damping = cpSpaceGetDamping(game_state_.space_);
+      if (ImGui::SliderFloat("Space Damping", &space_damping, 0.0f, 1.0f)){
+        cpSpaceSetDamping(game_state_.space_, space_damping);
+      }
     }
     // bar settings
     if (ImGui::CollapsingHeader("Bar Settings")){
-      ImGui::DragFloat2("Bar Position", &bar_position.x);
-      ImGui::DragFloat2("Bar Velocity", &bar_velocity.x);
-      ImGui::SliderFloat("Bar Angle", &bar_angle, -(kPid / 2), (kPid / 2));
-      ImGui::SliderFloat("Bar Friction", &bar_friction, 0.0f, 1.0f);
-      ImGui::SliderFloat("Bar Elasticity", &bar_elasticity, 0.0f, 1.0f);
-      ImGui::Checkbox("Bar Infinity", &bar_infinity);
-      if (!bar_infinity){
-        ImGui::SliderFloat("Bar Moment", &bar_moment, 0.0f, 1.0f);
-      }
+      ImGui::PushID(game_state_.cbar_);
+      EditBody(game_state_.cbar_, kBodyField_All & ~kBodyField_Mass);
+      ImGui::PopID();
     }
     // ball settings
     if (ImGui::CollapsingHeader("Ball Settings")){
-      ImGui::DragFloat2("Ball Position", &ball_position.x);
-      ImGui::DragFloat2("Ball Velocity", &ball_velocity.x);
-      ImGui::SliderFloat("Ball Angle", &ball_angle, -(kPid / 2), (kPid / 2));
-      ImGui::SliderFloat("Ball Mass", &ball_mass, 0.1f, 20.0f);
-      ImGui::SliderFloat("Ball Friction", &ball_friction, 0.0f, 1.0f);
-      ImGui::SliderFloat("Ball Elasticity", &ball_elasticity, 0.0f, 1.0f);
-      ImGui::Checkbox("Ball Infinity", &ball_infinity);
-      if (!ball_infinity){
-        ImGui::SliderFloat("Ball Moment", &ball_moment, 0.0f, 1.0f);
-      }
+      ImGui::PushID(game_state_.ball_);
+      EditBody(game_state_.ball_, kBodyField_All);
+      ImGui::PopID();
     }
     // bricks settings
     if (ImGui::CollapsingHeader("Bricks Settings")){
       for (unsigned short int i = 0; i < game_state_.bricks_amount_; i++){
         if (game_state_.bricks_[i].is_active_){
-          gtmath::Vec3 brick_position = game_state_.bricks_[i].handle_->position();
-          gtmath::Vec3 brick_velocity = game_state_.bricks_[i].handle_->velocity();
-          float brick_angle = game_state_.bricks_[i].handle_->angle();
-          float brick_friction = game_state_.bricks_[i].handle_->friction();
-          float brick_elasticity = game_state_.bricks_[i].handle_->elasticity();
-
-          std::string name;
-          name = "Brick" + std::to_string(i + 1);
-          if (ImGui::TreeNode(name.c_str())){
-            name = "Brick" + std::to_string(i + 1) + " Position";
-            ImGui::DragFloat2(name.c_str(), &brick_position.x);
-            name = "Brick" + std::to_string(i + 1) + " Velocity";
-            ImGui::DragFloat2(name.c_str(), &brick_velocity.x);
-            name = "Brick" + std::to_string(i + 1) + " Angle";
-            ImGui::SliderFloat(name.c_str(), &brick_angle, -(kPid / 2), (kPid / 2));
-            name = "Brick" + std::to_string(i + 1) + " Friction";
-            ImGui::SliderFloat(name.c_str(), &brick_friction, 0.0f, 1.0f);
-            name = "Brick" + std::to_string(i + 1) + " Elasticity";
-            ImGui::SliderFloat(name.c_str(), &brick_elasticity, 0.0f, 1.0f);
+          // the brick index is the node id, an open node scopes its widgets
+          if (ImGui::TreeNode((void*)(uintptr_t)i, "Brick%d", i + 1)){
+            EditBody(game_state_.bricks_[i].handle_, kBodyField_Brick);
             ImGui::TreePop();
           }
-
-          game_state_.bricks_[i].handle_->set_position(brick_position);
-          game_state_.bricks_[i].handle_->set_velocity(brick_velocity);
-          game_state_.bricks_[i].handle_->set_angle(brick_angle);
-          game_state_.bricks_[i].handle_->set_friction(brick_friction);
-          game_state_.bricks_[i].handle_->set_elasticity(brick_elasticity);
         }
       }
     }
+    levelEditor();
+    // profiler
+    if (ImGui::CollapsingHeader("Profiler")){
+      for (unsigned short int i = 0; i < kProfileSection_Count; i++){
+        const ProfileSample& sample = PROFILER.sample((ProfileSection)i);
+        ImGui::Text("%-18s %6.3f ms (avg %6.3f, peak %6.3f)",
+                    sample.name_, sample.last_, sample.average_, sample.peak_);
+      }
+      ImGui::Text("Particles: %u / %u",
+                  particles_->alive(), ParticleSystem::kMaxParticles);
+      ImGui::Text("Dropped events: %u, capped substeps: %u",
+                  game_state_.dropped_events_, game_state_.capped_substeps_);
+      ImGui::Text("Job workers: %u", JOBSYSTEM.numWorkers());
+      const ChipmunkAllocStats& physics = ChipmunkAllocLastFrame();
+      if (!ChipmunkAllocHooked()){
+        ImGui::Text("Physics allocs: not counted, chipmunk is not hooked");
+      }
+      else {
+        ImGui::Text("Physics allocs: %u (%u bytes, %u from system), "
+                    "live %u bytes", physics.allocs_, physics.bytes_,
+                    physics.system_allocs_,
+                    (unsigned int)ChipmunkAllocLiveBytes());
+      }
+      for (unsigned short int i = 0; i < kAllocTag_Count; i++){
+        const AllocStats& allocs = AllocLastFrame((AllocTag)i);
+        ImGui::Text("Allocs %-9s %4u (%u bytes)", AllocTagName((AllocTag)i),
+                    allocs.allocs_, allocs.bytes_);
+      }
+      // audio is left out, SoLoud makes an instance per voice played
+      bool strict = AllocStrictMask() != 0;
+      if (ImGui::Checkbox("Assert on frame allocations", &strict)){
+        AllocSetStrict(strict ? (1 << kAllocTag_Game) |
+                                (1 << kAllocTag_Physics) |
+                                (1 << kAllocTag_Render) : 0);
+      }
+      Arena& arena = game_state_.level_arena_;
+      ImGui::Text("Level arena: %u / %u bytes (peak %u)", arena.used(),
+                  arena.capacity(), arena.peak());
+      ImGui::Text("Entities: %u (%u sprites, %u bodies)",
+                  WORLD.numEntities(), WORLD.numSprites(),
+                  WORLD.physics_.size());
+      const AudioStats& audio = AUDIOMANAGER.stats();
+      ImGui::Text("Voices: %u (played %u, coalesced %u, stolen %u, "
+                  "dropped %u)", AUDIOMANAGER.activeVoices(), audio.played_,
+                  audio.coalesced_, audio.stolen_, audio.dropped_);
+      if (ImGui::Button("Reset Peaks")){ PROFILER.reset(); }
+    }
+    // input to frame submission
+    if (ImGui::CollapsingHeader("Input Latency")){
+      ImGui::Text("Samples: %u (dropped %u)", LATENCY.count(),
+                  LATENCY.dropped());
+      ImGui::Text("p50 %5.1f ms  p95 %5.1f ms  p99 %5.1f ms  max %5.1f ms",
+                  LATENCY.percentile(0.5f), LATENCY.percentile(0.95f),
+                  LATENCY.percentile(0.99f), LATENCY.peak());
+      if (ImGui::Button("Reset Latency")){ LATENCY.reset(); }
+    }
     if (ImGui::Button("Reset Level")){
+      // reset control vars
+      resetGame(current_level_);
+
       // reset space
       cpSpaceSetGravity(game_state_.space_, { 0.0f, 0.0f });
       cpSpaceSetDamping(game_state_.space_, 1.0f);
 
       // reset bar
-      bar_position = { lua_->getNumberFromTable("bar_settings", "cbar_x"),
-                       lua_->getNumberFromTable("bar_settings", "cbar_y"),
-                       1.0 };
-      bar_velocity = gtmath::Vec3Zero();
-      bar_angle = 0.0f;
-      bar_friction = lua_->getNumberFromTable("bar_settings", "friction");
-      bar_elasticity = lua_->getNumberFromTable("bar_settings", "elasticity");
-      bar_moment = lua_->getNumberFromTable("bar_settings", "moment");
-      bar_infinity = lua_->getBooleanFromTable("bar_settings", "infinity");
+      GameObject2D* bar = game_state_.cbar_;
+      bar->set_position({ lua_->getNumberFromTable("bar_settings", "cbar_x"),
+                          lua_->getNumberFromTable("bar_settings", "cbar_y"),
+                          1.0 });
+      bar->set_velocity(gtmath::Vec3Zero());
+      bar->set_angle(0.0f);
+      bar->set_friction(lua_->getNumberFromTable("bar_settings", "friction"));
+      bar->set_elasticity(lua_->getNumberFromTable("bar_settings",
+                                                   "elasticity"));
+      bar->set_moment(lua_->getNumberFromTable("bar_settings", "moment"));
+      bar->set_infinity(lua_->getBooleanFromTable("bar_settings",
+                                                  "infinity"));
 
       // reset ball
-      ball_position = { lua_->getNumberFromTable("ball_settings", "x"),
-                        lua_->getNumberFromTable("ball_settings", "y"),
-                        1.0f };
-      ball_velocity = gtmath::Vec3Zero();
-      ball_angle = 0.0f;
-      ball_mass = lua_->getNumberFromTable("ball_settings", "mass");
-      ball_friction = lua_->getNumberFromTable("ball_settings", "friction");
-      ball_elasticity = lua_->getNumberFromTable("ball_settings", "elasticity");
-      ball_moment = lua_->getNumberFromTable("ball_settings", "moment");
-      ball_infinity = lua_->getBooleanFromTable("ball_settings", "infinity");
-
-      // reset control vars
-      resetGame(level);
+      GameObject2D* ball = game_state_.ball_;
+      ball->set_position({ lua_->getNumberFromTable("ball_settings", "x"),
+                           lua_->getNumberFromTable("ball_settings", "y"),
+                           1.0f });
+      ball->set_velocity(gtmath::Vec3Zero());
+      ball->set_angle(0.0f);
+      ball->set_mass(lua_->getNumberFromTable("ball_settings", "mass"));
+      ball->set_friction(lua_->getNumberFromTable("ball_settings",
+                                                  "friction"));
+      ball->set_elasticity(lua_->getNumberFromTable("ball_settings",
+                                                    "elasticity"));
+      ball->set_moment(lua_->getNumberFromTable("ball_settings", "moment"));
+      ball->set_infinity(lua_->getBooleanFromTable("ball_settings",
+                                                   "infinity"));
     }
     ImGui::SameLine();
     if (ImGui::Button("Next Level")){
@@ -818,56 +1544,83 @@ void EngineScene::debug() {
     }
     ImGui::End();
     ImGui::Render();
+  }
+}
 
-    // game state set values
-    lifes_amount_ = lifes;
-    if (game_state_.drawcolliders_){
-      game_state_.cbar_->drawCollider(true);
-      game_state_.lbar_->drawCollider(true);
-      game_state_.rbar_->drawCollider(true);
-      game_state_.ball_->drawCollider(true);
-      for (unsigned short int i = 0; i < 4; i++){
-        game_state_.walls_[i]->drawCollider(true);
-      }
-      for (unsigned short int i = 0; i < game_state_.bricks_.size(); i++){
-        game_state_.bricks_[i].handle_->drawCollider(true);
-      }
+/// paint brick kinds on the field, each stroke rebuilds one brick at most
+void EngineScene::levelEditor() {
+
+  if (ImGui::CollapsingHeader("Level Editor")){
+    ImGui::Checkbox("Paint Bricks", &is_painting_);
+    ImGui::RadioButton("Gap", &editor_kind_, 0);
+    for (unsigned short int i = 1; i <= kNumBrickKinds; i++){
+      char label[8];
+      snprintf(label, 8, "%d", i);
+      ImGui::SameLine();
+      ImGui::RadioButton(label, &editor_kind_, i);
     }
-    else {
-      game_state_.cbar_->drawCollider(false);
-      game_state_.lbar_->drawCollider(false);
-      game_state_.rbar_->drawCollider(false);
-      game_state_.ball_->drawCollider(false);
-      for (unsigned short int i = 0; i < 4; i++){
-        game_state_.walls_[i]->drawCollider(false);
-      }
-      for (unsigned short int i = 0; i < game_state_.bricks_.size(); i++){
-        game_state_.bricks_[i].handle_->drawCollider(false);
-      }
+    ImGui::Text("Level %d: %d x %d cells, %d bricks", current_level_,
+                game_state_.level_cols_, game_state_.level_rows_,
+                game_state_.bricks_amount_);
+    if (ImGui::Button("Save Level")){ saveLevel(); }
+
+    // seeded levels, as big as wanted
+    LevelSpec& spec = editor_spec_;
+    int seed = spec.seed_;
+    int size[2] = { spec.cols_, spec.rows_ };
+    int pattern = spec.pattern_;
+    if (ImGui::InputInt("Seed", &seed)){ spec.seed_ = seed; }
+    if (ImGui::InputInt2("Columns / Rows", size)){
+      spec.cols_ = size[0] < 1 ? 1 : (size[0] > 1000 ? 1000 : size[0]);
+      spec.rows_ = size[1] < 1 ? 1 : (size[1] > 1000 ? 1000 : size[1]);
     }
+    ImGui::SliderFloat("Density", &spec.density_, 0.0f, 1.0f);
+    for (unsigned short int i = 0; i < kLevelPattern_Count; i++){
+      if (i > 0){ ImGui::SameLine(); }
+      ImGui::RadioButton(LevelPatternName((LevelPattern)i), &pattern, i);
+    }
+    spec.pattern_ = (LevelPattern)pattern;
+    // all weights at 0 is an even mix
+    for (unsigned short int i = 0; i < kNumBrickKinds; i++){
+      char label[16];
+      snprintf(label, 16, "Kind %d weight", i + 1);
+      ImGui::SliderFloat(label, &spec.kinds_[i], 0.0f, 1.0f);
+    }
+    if (ImGui::Button("Generate Level")){
+      generateLevel(spec);
+      resetLevel();
+    }
+  }
 
-    // space set values
-    cpSpaceSetGravity(game_state_.space_, { space_gravity.x, space_gravity.y });
-    cpSpaceSetDamping(game_state_.space_, space_damping);
-
-    // bar set values
-    game_state_.cbar_->set_position(bar_position);
-    game_state_.cbar_->set_velocity(bar_velocity);
-    game_state_.cbar_->set_angle(bar_angle);
-    game_state_.cbar_->set_friction(bar_friction);
-    game_state_.cbar_->set_elasticity(bar_elasticity);
-    game_state_.cbar_->set_moment(bar_moment);
-    game_state_.cbar_->set_infinity(bar_infinity);
-
-    // ball set values
-    game_state_.ball_->set_position(ball_position);
-    game_state_.ball_->set_velocity(ball_velocity);
-    game_state_.ball_->set_angle(ball_angle);
-    game_state_.ball_->set_mass(ball_mass);
-    game_state_.ball_->set_friction(ball_friction);
-    game_state_.ball_->set_elasticity(ball_elasticity);
-    game_state_.ball_->set_moment(ball_moment);
-    game_state_.ball_->set_infinity(ball_infinity);
+  // the field is under the mouse only when imgui does not want it
+  if (!is_painting_ || ImGui::GetIO().WantCaptureMouse ||
+      !ESAT::MouseButtonDown(0)){
+    return;
+  }
+
+  unsigned short int col = 0;
+  unsigned short int row = 0;
+  const gtmath::Vec3 mouse = { (float)ESAT::MousePositionX(),
+                               (float)ESAT::MousePositionY(),
+                               1.0f };
+  if (game_state_.brick_grid_.cellAt(mouse, &col, &row)){
+    editBrick(col, row, editor_kind_);
+  }
+}
+
+void EngineScene::drawColliders(const bool enabled) {
+
+  game_state_.cbar_->drawCollider(enabled);
+  game_state_.lbar_->drawCollider(enabled);
+  game_state_.rbar_->drawCollider(enabled);
+  game_state_.ball_->drawCollider(enabled);
+  for (unsigned short int i = 0; i < 4; i++){
+    game_state_.walls_[i]->drawCollider(enabled);
+  }
+  for (unsigned short int i = 0; i < game_state_.bricks_.size(); i++){
+    if (game_state_.bricks_[i].handle_ != nullptr){
+      game_state_.bricks_[i].handle_->drawCollider(enabled);
+    }
   }
 }
 
@@ -909,49 +1662,49 @@ void EngineScene::showInfo() {
 
   if (game_status_ == kGameStatus_Finished){
 
-    Text game_over;
-    Text total_score;
+    total_score_->set_value(score_amount_);
 
-    std::string buffer;
-    buffer = "TOTAL SCORE " + std::to_string(score_amount_);
+    game_over_->render();
+    total_score_->render();
+  }
+}
 
-    game_over.init("GAME OVER\0", { 268.0f, 420.0f }, 50);
-    total_score.init(buffer.c_str(), { 296.0f, 460.0f });
+/** getters **/
+const GameStatus EngineScene::gameStatus() {
 
-    game_over.render();
-    total_score.render();
-  }
+  return game_status_;
+}
+
+const unsigned short int EngineScene::currentLevel() {
+
+  return current_level_;
 }
 
 /** setters **/
 void EngineScene::set_levelNum(unsigned short int level) {
 
-  std::string buffer;
-  buffer = "LEVEL " + std::to_string(level);
-
-  level_->set_text(buffer.c_str());
+  level_->set_value(level);
 }
 
 void EngineScene::set_scoreAmount(unsigned short int score) {
 
-  std::string buffer;
-  buffer = "SCORE " + std::to_string(score);
-
-  score_->set_text(buffer.c_str());
+  score_->set_value(score);
 }
 
 /** reseters **/
 void EngineScene::resetBricks() {
 
   for (unsigned short int i = 0; i < game_state_.bricks_.size(); i++){
-    game_state_.bricks_[i].handle_->set_position(
-        { game_state_.bricks_[i].handle_->position().x - 1000.0f,
-          game_state_.bricks_[i].handle_->position().y,
-          1.0f });
-    game_state_.bricks_[i].handle_->removeBody();
+    killBrick(i);
   }
 
+  // the whole level goes at once, the next one reuses the same memory
+  game_state_.level_arena_.reset();
   game_state_.bricks_.clear();
+
+  // pending events point at the old bricks
+  game_state_.events_.clear();
+  game_state_.dying_.clear();
 }
 
 void EngineScene::resetLevel() {
@@ -1010,24 +1763,42 @@ void EngineScene::teleportObject(GameObject2D* object,
 /// destructor
 EngineScene::~EngineScene() {
 
-  // delete global struct
-  cpSpaceFree(game_state_.space_);
+  // delete global struct, objects leave the space before it is freed
+  resetBricks();
+  removeBalls();
   delete game_state_.cbar_;
+  delete game_state_.lbar_;
+  delete game_state_.rbar_;
   delete game_state_.ball_;
   game_state_.cbar_ = nullptr;
+  game_state_.lbar_ = nullptr;
+  game_state_.rbar_ = nullptr;
   game_state_.ball_ = nullptr;
   for (unsigned short int i = 0; i < 4; i++){
     delete game_state_.walls_[i];
     game_state_.walls_[i] = nullptr;
   }
+  cpSpaceFree(game_state_.space_);
 
   // delete private vars
   delete lua_;
+  delete particles_;
   delete level_;
   delete score_;
+  delete total_score_;
+  delete game_over_;
   delete life_;
+  delete gamepad_;
+  for (unsigned short int i = 0; i < kNumBrickSprites; i++){
+    Sprite::Release(brick_sprites_[i]);
+    brick_sprites_[i] = NULL;
+  }
   lua_ = nullptr;
+  particles_ = nullptr;
+  gamepad_ = nullptr;
   level_ = nullptr;
   score_ = nullptr;
+  total_score_ = nullptr;
+  game_over_ = nullptr;
   life_ = nullptr;
 }
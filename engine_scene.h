@@ -11,8 +11,10 @@
 
 #include <string>
 #include <vector>
+#ifndef __linux__
 #include <windows.h>
 #include <xinput.h>
+#endif
 
 #include <ESAT/window.h>
 #include <ESAT/input.h>
@@ -20,6 +22,7 @@
 #include <ESAT/time.h>
 
 #define WIN32
+#include "chipmunk_alloc.h"
 #include <ESAT_extra/chipmunk/chipmunk.h>
 #include <ESAT_extra/imgui.h>
 
@@ -27,9 +30,20 @@
 #include "luawrapper.h"
 #include "gtmath.h"
 #include "text.h"
+#include "hud.h"
 #include "sprite.h"
+#include "arena.h"
+#include "ecs.h"
 #include "gameobject2d.h"
 #include "gamepad.h"
+#include "brick_grid.h"
+#include "ring_buffer.h"
+#include "particle_system.h"
+#include "profiler.h"
+#include "job_system.h"
+#include "latency_tracker.h"
+#include "alloc_tracker.h"
+#include "level_generator.h"
 
 #define GAMEMANAGER GameManager::instance()
 #define AUDIOMANAGER AudioManager::instance()
@@ -40,9 +54,31 @@
 #define WALL_TAG 5
 #define LIMIT_TAG 6
 #define POWERUP_TAG 7
+#define BRICK_TAG 8
+// collision filter categories, pairs not sharing a bit never reach narrowphase
+#define BALL_CATEGORY (1 << 0)
+#define BAR_CATEGORY (1 << 1)
+#define WALL_CATEGORY (1 << 2)
+#define BRICK_CATEGORY (1 << 3)
 
 static const unsigned short int kGridCols = 10;
 static const unsigned short int kGridRows = 7;
+static const unsigned int kMaxCollisionEvents = 256;
+static const unsigned short int kNumBrickSprites = 8;
+// bytes, buildLevel grows the arena to fit each level
+static const unsigned int kLevelArenaSize = 128 * 1024;
+// levels hang from the top center of the field, one cell per brick; the
+// ones bigger than the area get smaller bricks
+static const float kLevelCenterX = 395.0f;
+static const float kLevelTop = 200.0f;
+static const float kLevelWidth = 660.0f;
+static const float kLevelHeight = 300.0f;
+static const float kBrickCellWidth = 50.0f;
+static const float kBrickCellHeight = 30.0f;
+static const unsigned int kMaxLevelBricks = 32767; // brick grid cells
+// levels saved by the editor, loaded over the config.lua tables
+static const char kLevelDirectory[] = "data/levels";
+static const char kLevelPath[] = "data/levels/level%d.lua";
 
 static enum GameStatus {
   kGameStatus_None = 0,
@@ -51,9 +87,48 @@ static enum GameStatus {
   kGameStatus_Finished
 };
 
+static enum CollisionEventKind {
+  kCollisionEvent_None = 0,
+  kCollisionEvent_Score,
+  kCollisionEvent_Die,
+  kCollisionEvent_Bounce,
+  kCollisionEvent_BounceLeft,
+  kCollisionEvent_BounceRight,
+  kCollisionEvent_Powerup
+};
+
+/// debug widgets shown for a body
+static enum BodyField {
+  kBodyField_Position = 1 << 0,
+  kBodyField_Velocity = 1 << 1,
+  kBodyField_Angle = 1 << 2,
+  kBodyField_Mass = 1 << 3,
+  kBodyField_Friction = 1 << 4,
+  kBodyField_Elasticity = 1 << 5,
+  kBodyField_Moment = 1 << 6,
+  kBodyField_Brick = kBodyField_Position | kBodyField_Velocity |
+                     kBodyField_Angle | kBodyField_Friction |
+                     kBodyField_Elasticity,
+  kBodyField_All = (1 << 7) - 1
+};
+
+struct CollisionEvent {
+  CollisionEventKind kind_;
+  unsigned short int type_a_; // collision type pair
+  unsigned short int type_b_;
+  unsigned short int brick_; // brick index, score events only
+  GameObject2D* ball_; // the one that hit, shape a
+  gtmath::Vec3 point_;
+  gtmath::Vec3 normal_;
+  float impulse_;
+};
+
 struct Brick {
   GameObject2D* handle_;
   unsigned short int type_; // 1 = normal, 2 = double
+  unsigned short int kind_; // sprite / color kind, 1 to 7
+  unsigned short int col_;
+  unsigned short int row_;
   bool is_active_;
   bool must_die_;
 };
@@ -64,14 +139,29 @@ struct GameState {
   GameObject2D* lbar_;
   GameObject2D* rbar_;
   GameObject2D* ball_;
+  std::vector<GameObject2D*> balls_; // extra ones, see addBall()
   GameObject2D* walls_[4];
   std::vector<Brick> bricks_;
+  std::vector<unsigned short int> level_cells_; // kinds as authored, 0 gaps
+  unsigned short int level_cols_;
+  unsigned short int level_rows_;
+  float brick_scale_; // 1 unless the level is too big for the field
+  Arena level_arena_; // owns every object levelDump creates
+  BrickGrid brick_grid_;
   unsigned short int bricks_amount_;
-  // 0 = not update, 1 = score, 2 = die, 3 = bounce, 4 = powerup
-  unsigned short int updating_;
+  // pushed by the physics callbacks, drained once per frame by updateScene()
+  RingBuffer<CollisionEvent, kMaxCollisionEvents> events_;
+  unsigned int dropped_events_;
+  // steps whose substeps hit the cap, a ball may tunnel in those
+  unsigned int capped_substeps_;
+  // bricks HitBrick broke, killed by updateScene() even if their event was
+  // dropped; a brick breaks once, so kMaxLevelBricks always fits
+  std::vector<unsigned short int> dying_;
   bool godmode_;
   bool freemode_;
   bool drawcolliders_;
+  bool analytic_bricks_; // ball vs bricks solved by the grid, not chipmunk
+  bool ccd_; // continuous collision detection for the ball
 };
 
 class EngineScene {
@@ -86,12 +176,59 @@ class EngineScene {
     void initMap();
     void initTexts();
     void initSprites();
+    void initBall(GameObject2D* ball);
     void initBrick(unsigned short int index,
-                   unsigned short int x,
-                   unsigned short int y,
+                   const float x,
+                   const float y,
                    unsigned short int kind);
+    void killBrick(unsigned short int index);
     void levelDump(unsigned short int level);
 
+    /**
+     * @brief one more ball, launched from the start position; extra balls
+     *        score and bounce like the first one but never cost a life
+     * @param none
+     * @return void
+     **/
+    void addBall();
+    void removeBalls(); // every extra ball
+
+    /**
+     * @brief put an extra ball back at the start, going up to one side
+     * @param GameObject2D* ball, const unsigned int index (picks the side)
+     * @return void
+     **/
+    void launchBall(GameObject2D* ball, const unsigned int index);
+
+    /// a brick for every cell of level_cells_, on a fresh grid
+    void buildLevel();
+
+    /**
+     * @brief replace the level with a generated one, built the same way
+     *        levelDump builds the config.lua ones
+     * @param const LevelSpec& spec
+     * @return void
+     **/
+    void generateLevel(const LevelSpec& spec);
+
+    /**
+     * @brief change one cell of the level, only the brick there is touched
+     * @param const unsigned short int col, const unsigned short int row,
+     *        const unsigned short int kind (0 for a gap)
+     * @return void
+     **/
+    void editBrick(const unsigned short int col,
+                   const unsigned short int row,
+                   const unsigned short int kind);
+
+    /**
+     * @brief write the level as authored to kLevelPath, in the same table
+     *        format as config.lua plus its cols and rows
+     * @param none
+     * @return const bool
+     **/
+    const bool saveLevel();
+
     /// init values
     void init();
 
@@ -99,26 +236,60 @@ class EngineScene {
     void updateScene();
     void updateBar();
     void updateBall();
-    void updateBricks();
+
+    /** sync functions **/
+    void syncObjects();
+
+    /**
+     * @brief sweep a ball through the brick grid and bounce it off the
+     *        first bricks it meets during this step
+     * @param GameObject2D* ball, const double delta_time
+     * @return void
+     **/
+    void sweepBall(GameObject2D* ball, const double delta_time);
+
+    /**
+     * @brief earliest time of impact of a ball against walls, bar and
+     *        bricks along a step (1 when nothing is hit)
+     * @param GameObject2D* ball, const float step
+     * @return const float
+     **/
+    const float ballTimeOfImpact(GameObject2D* ball, const float step);
+
+    /**
+     * @brief step the chipmunk space, sub-stepping around the earliest ball
+     *        time of impact when any ball moves fast enough to tunnel
+     * @param const double delta_time
+     * @return void
+     **/
+    void stepSpace(const double delta_time);
 
     /** render functions **/
-    void renderScenario();
     void renderLifes();
 
     /** GUI **/
     void HUD();
     void debug();
+    void levelEditor(); // debug mode only, the simulation is not threaded
+    void drawColliders(const bool enabled);
 
     /** game flow **/
+    void sampleInput(); // every input change starts a latency sample
     void input();
+    void autopilot(); // plays on its own instead of input(), for headless
     void update(const double delta_time);
-    void render();
+    void render(); // records the frame into the render queue
+    void present(); // draws the last recorded frame
 
     /** checkers **/
     void checkStatus();
     const bool isLevelFinished();
     void showInfo();
 
+    /** getters **/
+    const GameStatus gameStatus();
+    const unsigned short int currentLevel();
+
     /** setters **/
     void set_levelNum(unsigned short int level);
     void set_scoreAmount(unsigned short int score);
@@ -159,9 +330,13 @@ class EngineScene {
     GameStatus game_status_;
     Gamepad* gamepad_;
     LuaWrapper* lua_;
-    Text* level_;
-    Text* score_;
+    ParticleSystem* particles_;
+    HUDCounter* level_;
+    HUDCounter* score_;
+    HUDCounter* total_score_;
+    Text* game_over_;
     Sprite* life_;
+    ESAT::SpriteHandle brick_sprites_[kNumBrickSprites];
     gtmath::Vec3 bar_velocity_;
     unsigned short int total_levels_;
     unsigned short int current_level_;
@@ -172,8 +347,13 @@ class EngineScene {
     float bar_speed_;
     float bar_friction_;
     float ball_speed_;
+    double last_pad_time_; // ms, newest gamepad event already sampled
+    unsigned int input_sequence_; // newest input sample, 0 if none
+    int editor_kind_; // painted by the level editor, 0 erases
+    LevelSpec editor_spec_; // of the generator in the level editor
     bool is_joint_;
-    char padding_[3]; /// word padding
+    bool is_painting_;
+    char padding_[2]; /// word padding
 };
 
 #endif
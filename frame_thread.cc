@@ -0,0 +1,93 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief FrameThread Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "frame_thread.h"
+
+/// constructor
+FrameThread::FrameThread() {
+
+  job_ = nullptr;
+  data_ = nullptr;
+  is_pending_ = false;
+  is_running_ = false;
+}
+
+/**
+ * @brief start the thread, it sleeps until kicked
+ * @param void (*job)(void*), void* data
+ * @return void
+ **/
+void FrameThread::start(void (*job)(void*), void* data) {
+
+  if (is_running_){ return; }
+
+  job_ = job;
+  data_ = data;
+  is_pending_ = false;
+  is_running_ = true;
+  thread_ = std::thread(&FrameThread::run, this);
+}
+
+/// run the job once
+void FrameThread::kick() {
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  is_pending_ = true;
+  kicked_.notify_one();
+}
+
+/// block until the last kicked job is done
+void FrameThread::wait() {
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (is_pending_){ done_.wait(lock); }
+}
+
+/// finish the thread
+void FrameThread::stop() {
+
+  if (!is_running_){ return; }
+
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_running_ = false;
+    kicked_.notify_one();
+  }
+  thread_.join();
+}
+
+/// thread loop
+void FrameThread::run() {
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true){
+    while (!is_pending_ && is_running_){ kicked_.wait(lock); }
+    if (!is_running_){ return; }
+
+    lock.unlock();
+    job_(data_);
+    lock.lock();
+
+    is_pending_ = false;
+    done_.notify_one();
+  }
+}
+
+/** getters **/
+const bool FrameThread::running() {
+
+  return is_running_;
+}
+
+/// destructor
+FrameThread::~FrameThread() {
+
+  stop();
+}
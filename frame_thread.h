@@ -0,0 +1,64 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief FrameThread Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __FRAMETHREAD_H__
+#define __FRAMETHREAD_H__ 1
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/// runs one job per frame on its own thread, the caller joins it with wait
+class FrameThread {
+
+  public:
+
+    /// constructor & destructor
+    FrameThread();
+    ~FrameThread();
+
+    /**
+     * @brief start the thread, it sleeps until kicked
+     * @param void (*job)(void*), void* data
+     * @return void
+     **/
+    void start(void (*job)(void*), void* data);
+
+    /// run the job once
+    void kick();
+
+    /// block until the last kicked job is done
+    void wait();
+
+    /// finish the thread
+    void stop();
+
+    /** getters **/
+    const bool running();
+
+  private:
+
+    /// copy constructor
+    FrameThread(const FrameThread& copy);
+    FrameThread operator=(const FrameThread& copy);
+
+    /// thread loop
+    void run();
+
+    /// private vars
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable kicked_;
+    std::condition_variable done_;
+    void (*job_)(void*);
+    void* data_;
+    bool is_pending_;
+    bool is_running_;
+};
+
+#endif
@@ -22,6 +22,7 @@ GameManager::GameManager() {
   stage_height_ = 0;
   sleep_MS_ = 0.0f;
   debug_mode_ = false;
+  headless_ = false;
   engine_scene_ = nullptr;
 }
 
@@ -32,6 +33,7 @@ GameManager::GameManager(const GameManager& copy) {
   stage_height_ = copy.stage_height_;
   sleep_MS_ = copy.sleep_MS_;
   debug_mode_ = copy.debug_mode_;
+  headless_ = copy.headless_;
   engine_scene_ = copy.engine_scene_;
 }
 
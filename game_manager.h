@@ -30,6 +30,7 @@ class GameManager {
 
     /// public vars
     bool debug_mode_;
+    bool headless_; // no window, see RunHeadless in main.cc
     EngineScene* engine_scene_;
 
   private:
@@ -7,24 +7,36 @@
 
 #include "gameobject2d.h"
 
+/// vertices handed to chipmunk, which copies them; on the stack when few
+struct ShapeVerts {
+
+  static const unsigned short int kMaxStackVerts = 32;
+
+  ShapeVerts(const unsigned short int count) {
+    data_ = count <= kMaxStackVerts ? stack_ : new cpVect[count];
+  }
+  ~ShapeVerts() { if (data_ != stack_){ delete[] data_; } }
+
+  cpVect stack_[kMaxStackVerts];
+  cpVect* data_;
+};
+
 /// constructor
-GameObject2D::GameObject2D() {
+GameObject2D::GameObject2D(const DrawLayer layer) {
 
+  entity_ = WORLD.create();
+  TransformComponent& transform = WORLD.transforms_.add(entity_);
+  transform.x_ = 0.0f;
+  transform.y_ = 0.0f;
+  transform.angle_ = 0.0f;
   space_ = nullptr;
   body_ = nullptr;
   shape_ = nullptr;
-  box_ = nullptr;
-  poly_ = nullptr;
-  sprite_ = nullptr;
-  body_type_ = kBodyType_None;
   body_kind_ = kBodyKind_None;
-  pointA_ = gtmath::Vec3Zero();
-  pointB_ = gtmath::Vec3Zero();
-  tag_ = 0;
+  layer_ = layer;
   moment_ = 0.0f;
-  has_sprite_ = false;
-  is_visible_ = false;
   is_infinity_ = false;
+  is_simulated_ = false;
 }
 
 /// init values
@@ -49,7 +61,8 @@ void GameObject2D::init(cpSpace* space,
     } break;
   }
 
-  is_visible_ = true;
+  WORLD.physics_.add(entity_).body_ = body_;
+  is_simulated_ = true;
 }
 
 /** add bodies **/
@@ -60,17 +73,16 @@ void GameObject2D::addBodySegment(const gtmath::Vec3 pointA,
                                   const float radius,
                                   const float mass) {
 
-  body_type_ = kBodyType_Segment;
-
-  pointA_ = pointA;
-  pointB_ = pointB;
+  const cpVect points[2] = { { pointA.x, pointA.y }, { pointB.x, pointB.y } };
 
   shape_ = cpSpaceAddShape(space_, cpSegmentShapeNew(body_,
-                                                     { pointA_.x, pointA_.y },
-                                                     { pointB_.x, pointB_.y },
+                                                     points[0],
+                                                     points[1],
                                                      radius));
   if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
   cpShapeSetFriction(shape_, friction);
+
+  addCollider(points, 2, { 255.0f, 255.0f, 255.0f }, false);
 }
 
 /// box shape
@@ -81,39 +93,32 @@ void GameObject2D::addBodyBox(const float width,
                               const float friction,
                               const float radius) {
 
-  body_type_ = kBodyType_Box;
-
   shape_ = cpSpaceAddShape(space_, cpBoxShapeNew(body_, width, height, radius));
   if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
   cpShapeSetFriction(shape_, friction);
-  cpBodySetPosition(body_, { position.x, position.y });
+  set_position(position);
 
-  box_ = new Box();
-  box_->init(width, height);
+  const cpVect corners[4] = { { -width / 2, -height / 2 },
+                              { width / 2, -height / 2 },
+                              { width / 2, height / 2 },
+                              { -width / 2, height / 2 } };
+  addCollider(corners, 4, { 100.0f, 220.0f, 125.0f }, true);
 }
 
 void GameObject2D::addBodyBox(const char* path,
                               const gtmath::Vec3 position,
                               const float mass,
                               const float friction,
-                              const float radius) {
+                              const float radius,
+                              const float scale) {
 
-  body_type_ = kBodyType_Box;
-  has_sprite_ = true;
+  addSprite(path, scale);
 
-  sprite_ = new Sprite();
-  sprite_->init(path, position);
-
-  shape_ = cpSpaceAddShape(space_, cpBoxShapeNew(body_,
-                                                 sprite_->width(),
-                                                 sprite_->height(),
-                                                 radius));
-  if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
-  cpShapeSetFriction(shape_, friction);
-  cpBodySetPosition(body_, { position.x, position.y });
+  float width = 0.0f;
+  float height = 0.0f;
+  Sprite::Size(WORLD.sprites_[layer_].get(entity_).handle_, &width, &height);
 
-  box_ = new Box();
-  box_->init(sprite_->width(), sprite_->height());
+  addBodyBox(width * scale, height * scale, position, mass, friction, radius);
 }
 
 /// polygon regular shape
@@ -124,29 +129,23 @@ void GameObject2D::addBodyCircle(const unsigned short int num_verts,
                                  const float friction,
                                  const float radius) {
 
-  body_type_ = kBodyType_Polygon;
-
-  cpVect* points = new cpVect[num_verts];
+  ShapeVerts points(num_verts);
 
   for (unsigned short int i = 0; i < num_verts; i++){
-    points[i].x = size * cos(2 * kPid * i / num_verts);
-    points[i].y = size * sin(2 * kPid * i / num_verts);
+    points.data_[i].x = size * cos(2 * kPid * i / num_verts);
+    points.data_[i].y = size * sin(2 * kPid * i / num_verts);
   }
 
   shape_ = cpSpaceAddShape(space_, cpPolyShapeNewRaw(body_,
                                                      num_verts,
-                                                     points,
+                                                     points.data_,
                                                      radius));
 
-  delete points;
-  points = nullptr;
-
   if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
   cpShapeSetFriction(shape_, friction);
-  cpBodySetPosition(body_, { position.x, position.y });
+  set_position(position);
 
-  poly_ = new Poly();
-  poly_->init(num_verts, size);
+  addCollider(points.data_, num_verts, { 255.0f, 255.0f, 255.0f }, true);
 }
 
 void GameObject2D::addBodyCircle(const char* path,
@@ -157,33 +156,8 @@ void GameObject2D::addBodyCircle(const char* path,
                                  const float friction,
                                  const float radius) {
 
-  body_type_ = kBodyType_Polygon;
-  has_sprite_ = true;
-
-  sprite_ = new Sprite();
-  sprite_->init(path, position);
-
-  cpVect* points = new cpVect[num_verts];
-
-  for (unsigned short int i = 0; i < num_verts; i++){
-    points[i].x = size * cos(2 * kPid * i / num_verts);
-    points[i].y = size * sin(2 * kPid * i / num_verts);
-  }
-
-  shape_ = cpSpaceAddShape(space_, cpPolyShapeNewRaw(body_,
-                                                     num_verts,
-                                                     points,
-                                                     radius));
-
-  delete points;
-  points = nullptr;
-
-  if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
-  cpShapeSetFriction(shape_, friction);
-  cpBodySetPosition(body_, { position.x, position.y });
-
-  poly_ = new Poly();
-  poly_->init(num_verts, size);
+  addSprite(path);
+  addBodyCircle(num_verts, size, position, mass, friction, radius);
 }
 
 /// polygon free shape
@@ -194,71 +168,23 @@ void GameObject2D::addBodyPoly(const unsigned short int num_verts,
                                const float friction,
                                const float radius) {
 
-  body_type_ = kBodyType_Polygon;
-
-  cpVect* points = new cpVect[num_verts];
+  ShapeVerts points(num_verts);
 
   for (unsigned short int i = 0; i < num_verts; i++){
-    points[i].x = verts[i].x;
-    points[i].y = verts[i].y;
+    points.data_[i].x = verts[i].x;
+    points.data_[i].y = verts[i].y;
   }
 
   shape_ = cpSpaceAddShape(space_, cpPolyShapeNewRaw(body_,
                                                      num_verts,
-                                                     points,
+                                                     points.data_,
                                                      radius));
 
-  delete points;
-  points = nullptr;
-
   if (body_kind_ == kBodyKind_Dynamic){ cpShapeSetMass(shape_, mass); }
   cpShapeSetFriction(shape_, friction);
-  cpBodySetPosition(body_, { position.x, position.y });
+  set_position(position);
 
-  poly_ = new Poly();
-  poly_->init(num_verts, verts);
-}
-
-/**
- * @brief update object position and render it
- * @param none
- * @return void
- **/
-void GameObject2D::update() {
-
-  if (body_ != nullptr){
-    switch (body_type_){
-      case kBodyType_Segment: {
-        if (is_visible_){
-          ESAT::DrawSetStrokeColor(255, 255, 255, 255);
-          ESAT::DrawLine(pointA_.x, pointA_.y, pointB_.x, pointB_.y);
-        }
-      } break;
-      case kBodyType_Box: {
-        box_->set_position({ cpBodyGetPosition(body_).x,
-                             cpBodyGetPosition(body_).y,
-                             1.0f });
-        box_->set_rotation(cpBodyGetAngle(body_));
-        if (is_visible_){ box_->render(); }
-      } break;
-      case kBodyType_Circle:
-      case kBodyType_Polygon: {
-        poly_->set_position({ cpBodyGetPosition(body_).x,
-                              cpBodyGetPosition(body_).y,
-                              1.0f });
-        poly_->set_rotation(cpBodyGetAngle(body_));
-        if (is_visible_){ poly_->render(); }
-      } break;
-    }
-
-    if (has_sprite_){
-      sprite_->set_position({ cpBodyGetPosition(body_).x,
-                              cpBodyGetPosition(body_).y,
-                              1.0f });
-      sprite_->set_rotation(cpBodyGetAngle(body_));
-      sprite_->render();
-    }
-  }
+  addCollider(points.data_, num_verts, { 100.0f, 220.0f, 125.0f }, true);
 }
 
 /// add a force to a specified point of the object
@@ -272,15 +198,10 @@ void GameObject2D::set_position(const gtmath::Vec3 position) {
 
   cpBodySetPosition(body_, { position.x, position.y });
 
-  switch (body_type_){
-    case kBodyType_Box: {
-      box_->set_position({ position.x, position.y, 1.0f });
-    } break;
-    case kBodyType_Circle:
-    case kBodyType_Polygon: {
-      poly_->set_position({ position.x, position.y, 1.0f });
-    } break;
-  }
+  // drawn there before the next sync too
+  TransformComponent& transform = WORLD.transforms_.get(entity_);
+  transform.x_ = position.x;
+  transform.y_ = position.y;
 }
 
 void GameObject2D::set_velocity(const gtmath::Vec3 velocity) {
@@ -309,9 +230,11 @@ void GameObject2D::set_elasticity(const float elasticity) {
   cpShapeSetElasticity(shape_, elasticity);
 }
 
-void GameObject2D::set_moment(const bool inertia) {
+void GameObject2D::set_moment(const float moment) {
+
+  moment_ = moment;
 
-  cpBodySetMoment(body_, inertia);
+  if (!is_infinity_){ cpBodySetMoment(body_, moment_); }
 }
 
 void GameObject2D::set_infinity(const bool infinity) {
@@ -324,18 +247,60 @@ void GameObject2D::set_infinity(const bool infinity) {
 
 void GameObject2D::set_visible(const bool visible) {
 
-  is_visible_ = visible;
+  if (WORLD.sprites_[layer_].has(entity_)){
+    WORLD.sprites_[layer_].get(entity_).visible_ = visible;
+  }
+  if (WORLD.colliders_[layer_].has(entity_)){
+    WORLD.colliders_[layer_].get(entity_).visible_ = visible;
+  }
 }
 
 void GameObject2D::set_sprite(const char* path) {
 
-  sprite_->set_sprite(path);
+  if (!WORLD.sprites_[layer_].has(entity_)){
+    addSprite(path);
+    return;
+  }
+
+  SpriteComponent& sprite = WORLD.sprites_[layer_].get(entity_);
+  ESAT::SpriteHandle handle = Sprite::Acquire(path);
+  Sprite::Release(sprite.handle_);
+  sprite.handle_ = handle;
 }
 
 void GameObject2D::set_tag(const unsigned short int tag) {
 
-  tag_ = tag;
-  cpShapeSetCollisionType(shape_, tag_);
+  WORLD.tags_.add(entity_).tag_ = tag;
+  cpShapeSetCollisionType(shape_, tag);
+}
+
+/// add or take out the body and its shape from the space, keeping them alive
+void GameObject2D::set_simulated(const bool simulated) {
+
+  if (simulated == is_simulated_ || body_ == nullptr){ return; }
+
+  is_simulated_ = simulated;
+
+  if (is_simulated_){
+    cpSpaceAddBody(space_, body_);
+    if (shape_ != nullptr){ cpSpaceAddShape(space_, shape_); }
+  }
+  else {
+    if (shape_ != nullptr){ cpSpaceRemoveShape(space_, shape_); }
+    cpSpaceRemoveBody(space_, body_);
+  }
+}
+
+/// categories this shape belongs to and categories it collides with
+void GameObject2D::set_filter(const unsigned int categories,
+                              const unsigned int mask) {
+
+  cpShapeSetFilter(shape_, cpShapeFilterNew(CP_NO_GROUP, categories, mask));
+}
+
+void GameObject2D::set_userData(void* data) {
+
+  cpShapeSetUserData(shape_, data);
 }
 
 /** getters **/
@@ -389,14 +354,16 @@ const bool GameObject2D::infinity() {
 
 const float GameObject2D::width() {
 
-  if (body_type_ == kBodyType_Box){ return box_->width(); }
-  else { return 0.0f; }
+  if (!WORLD.colliders_[layer_].has(entity_)){ return 0.0f; }
+
+  return WORLD.colliders_[layer_].get(entity_).width_;
 }
 
 const float GameObject2D::height() {
 
-  if (body_type_ == kBodyType_Box){ return box_->height(); }
-  else { return 0.0f; }
+  if (!WORLD.colliders_[layer_].has(entity_)){ return 0.0f; }
+
+  return WORLD.colliders_[layer_].get(entity_).height_;
 }
 
 const unsigned short int GameObject2D::numVerts() {
@@ -417,61 +384,118 @@ const unsigned short int GameObject2D::tag() {
   return cpShapeGetCollisionType(shape_);
 }
 
-/// draw collider
+const bool GameObject2D::simulated() {
+
+  return is_simulated_;
+}
+
+void* GameObject2D::userData() {
+
+  return cpShapeGetUserData(shape_);
+}
+
+const Entity GameObject2D::entity() {
+
+  return entity_;
+}
+
+/// draw collider, segments are always drawn
 void GameObject2D::drawCollider(const bool enabled) {
 
-  switch (body_type_){
-    case kBodyType_Box: {
-      if (enabled){ box_->drawLines(true); }
-      else { box_->drawLines(false); }
-    } break;
-    case kBodyType_Circle:
-    case kBodyType_Polygon: {
-      if (enabled){ poly_->drawLines(true); }
-      else { poly_->drawLines(false); }
-    } break;
-  }
+  if (!WORLD.colliders_[layer_].has(entity_)){ return; }
+
+  ColliderComponent& collider = WORLD.colliders_[layer_].get(entity_);
+  if (collider.closed_){ collider.outline_ = enabled; }
 }
 
 /// delete body from space
 void GameObject2D::removeBody() {
 
   if (shape_ != nullptr){
-    cpSpaceRemoveShape(space_, shape_);
+    if (is_simulated_){ cpSpaceRemoveShape(space_, shape_); }
     cpShapeDestroy(shape_);
     cpShapeFree(shape_);
     shape_ = nullptr;
   }
 
   if (body_ != nullptr){
-    cpSpaceRemoveBody(space_, body_);
+    if (is_simulated_){ cpSpaceRemoveBody(space_, body_); }
     cpBodyDestroy(body_);
     cpBodyFree(body_);
     body_ = nullptr;
   }
+
+  // the transform keeps the last synced place
+  WORLD.physics_.remove(entity_);
+  is_simulated_ = false;
+}
+
+/**
+ * @brief outline of the shape in body space, sampled down to
+ *        kMaxColliderVerts when it has more
+ * @param const cpVect* verts, const unsigned short int num_verts,
+ *        const gtmath::Vec3 color, const bool closed
+ * @return void
+ **/
+void GameObject2D::addCollider(const cpVect* verts,
+                               const unsigned short int num_verts,
+                               const gtmath::Vec3 color,
+                               const bool closed) {
+
+  ColliderComponent& collider = WORLD.colliders_[layer_].add(entity_);
+
+  collider.num_verts_ = num_verts < kMaxColliderVerts ? num_verts :
+                                                        kMaxColliderVerts;
+  float min_x = 0.0f, max_x = 0.0f, min_y = 0.0f, max_y = 0.0f;
+  for (unsigned short int i = 0; i < collider.num_verts_; i++){
+    const cpVect vert = verts[i * num_verts / collider.num_verts_];
+    collider.verts_[i * 2] = (float)vert.x;
+    collider.verts_[i * 2 + 1] = (float)vert.y;
+    if (i == 0 || vert.x < min_x){ min_x = (float)vert.x; }
+    if (i == 0 || vert.x > max_x){ max_x = (float)vert.x; }
+    if (i == 0 || vert.y < min_y){ min_y = (float)vert.y; }
+    if (i == 0 || vert.y > max_y){ max_y = (float)vert.y; }
+  }
+  collider.width_ = max_x - min_x;
+  collider.height_ = max_y - min_y;
+  collider.color_[0] = (unsigned char)color.x;
+  collider.color_[1] = (unsigned char)color.y;
+  collider.color_[2] = (unsigned char)color.z;
+  collider.alpha_ = 255;
+  collider.closed_ = closed;
+  collider.outline_ = !closed;
+  collider.visible_ = true;
+}
+
+/// load the sprite centered on the entity
+void GameObject2D::addSprite(const char* path, const float scale) {
+
+  SpriteComponent& sprite = WORLD.sprites_[layer_].add(entity_);
+
+  float width = 0.0f;
+  float height = 0.0f;
+  sprite.handle_ = Sprite::Acquire(path);
+  Sprite::Size(sprite.handle_, &width, &height);
+  ESAT::SpriteTransformInit(&sprite.transform_);
+  sprite.transform_.sprite_origin_x = width / 2;
+  sprite.transform_.sprite_origin_y = height / 2;
+  sprite.transform_.scale_x = scale;
+  sprite.transform_.scale_y = scale;
+  sprite.visible_ = true;
+}
+
+/// leave the space and the world, the object is an empty shell after it
+void GameObject2D::destroy() {
+
+  // the space is shared and owned by the scene, only leave it
+  removeBody();
+  WORLD.destroy(entity_);
+  entity_ = kNoEntity;
+  space_ = nullptr;
 }
 
 /// destructor
 GameObject2D::~GameObject2D() {
 
-  cpSpaceFree(space_);
-  if (shape_ != nullptr){
-    cpSpaceRemoveShape(space_, shape_);
-    cpShapeDestroy(shape_);
-    cpShapeFree(shape_);
-    shape_ = nullptr;
-  }
-  if (body_ != nullptr){
-    cpSpaceRemoveBody(space_, body_);
-    cpBodyDestroy(body_);
-    cpBodyFree(body_);
-    body_ = nullptr;
-  }
-  delete box_;
-  delete poly_;
-  delete sprite_;
-  space_ = nullptr;
-  box_ = nullptr;
-  poly_ = nullptr;
-  sprite_ = nullptr;
+  destroy();
 }
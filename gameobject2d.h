@@ -12,12 +12,12 @@
 #include <stdlib.h>
 
 #define WIN32
+#include "chipmunk_alloc.h"
 #include <ESAT_extra/chipmunk/chipmunk.h>
 
 #include "gtmath.h"
-#include "box.h"
-#include "poly.h"
 #include "sprite.h"
+#include "ecs.h"
 
 static enum BodyKind {
   kBodyKind_None = 0,
@@ -26,20 +26,16 @@ static enum BodyKind {
   kBodyKind_Static
 };
 
-static enum BodyType {
-  kBodyType_None = 0,
-  kBodyType_Segment,
-  kBodyType_Box,
-  kBodyType_Circle,
-  kBodyType_Polygon
-};
-
+/**
+ * an entity of the WORLD plus the chipmunk body and shape behind it, what
+ * is drawn lives in its components and the world systems sync and draw it
+ **/
 class GameObject2D {
 
   public:
 
     /// constructor & destructor
-    GameObject2D();
+    GameObject2D(const DrawLayer layer = kDrawLayer_Scenario);
     ~GameObject2D();
 
     /// init values
@@ -62,7 +58,8 @@ class GameObject2D {
     */
 
     /*
-    // use this to add a collision handler
+    // use this to add a collision handler (see also set_filter to keep
+    // pairs that never matter out of the broadphase)
     cpBool Collision(cpArbiter *arbiter, cpSpace *space, void *data) {
       cpShape* a = NULL;
       cpShape* b = NULL;
@@ -96,7 +93,8 @@ class GameObject2D {
                     const gtmath::Vec3 position = { 0.0f, 0.0f, 1.0f },
                     const float mass = 10.0f,
                     const float friction = 0.5f,
-                    const float radius = 1.0f);
+                    const float radius = 1.0f,
+                    const float scale = 1.0f); // of the sprite and the box
     /// circle body
     void addBodyCircle(const unsigned short int num_verts = 10,
                        const float size = 50.0f,
@@ -119,13 +117,6 @@ class GameObject2D {
                      const float friction = 0.5f,
                      const float radius = 1.0f);
 
-    /**
-     * @brief update object position and render it
-     * @param none
-     * @return void
-     **/
-    void update();
-
     /// add a force to a specified point of the object
     void addForce(const gtmath::Vec3 force);
 
@@ -136,11 +127,14 @@ class GameObject2D {
     void set_mass(const float mass);
     void set_friction(const float friction);
     void set_elasticity(const float elasticity);
-    void set_moment(const bool inertia);
+    void set_moment(const float moment);
     void set_infinity(const bool infinity);
     void set_visible(const bool visible);
     void set_sprite(const char* path);
     void set_tag(const unsigned short int tag);
+    void set_simulated(const bool simulated);
+    void set_filter(const unsigned int categories, const unsigned int mask);
+    void set_userData(void* data);
 
     /** getters **/
     const gtmath::Vec3 position();
@@ -156,6 +150,9 @@ class GameObject2D {
     const unsigned short int numVerts();
     const gtmath::Vec3 vert(unsigned short int vert);
     const unsigned short int tag();
+    const bool simulated();
+    void* userData();
+    const Entity entity();
 
     /// draw collider
     void drawCollider(const bool enabled);
@@ -163,28 +160,40 @@ class GameObject2D {
     /// delete body from space
     void removeBody();
 
+    /// leave the space and the world, the object is an empty shell after it
+    void destroy();
+
   private:
 
     /// copy constructor
     GameObject2D(const GameObject2D& copy);
     GameObject2D operator=(const GameObject2D& copy);
 
+    /**
+     * @brief outline of the shape in body space, sampled down to
+     *        kMaxColliderVerts when it has more
+     * @param const cpVect* verts, const unsigned short int num_verts,
+     *        const gtmath::Vec3 color, const bool closed
+     * @return void
+     **/
+    void addCollider(const cpVect* verts,
+                     const unsigned short int num_verts,
+                     const gtmath::Vec3 color,
+                     const bool closed);
+
+    /// load the sprite centered on the entity
+    void addSprite(const char* path, const float scale = 1.0f);
+
     /// private vars
+    Entity entity_;
     cpSpace* space_;
     cpBody* body_;
     cpShape* shape_;
-    Box* box_;
-    Poly* poly_;
-    Sprite* sprite_;
     BodyKind body_kind_;
-    BodyType body_type_;
-    gtmath::Vec3 pointA_;
-    gtmath::Vec3 pointB_;
-    unsigned short int tag_;
+    DrawLayer layer_;
     float moment_;
-    bool has_sprite_;
-    bool is_visible_;
     bool is_infinity_;
+    bool is_simulated_;
 };
 
 #endif
@@ -1,12 +1,33 @@
 #include "gamepad.h"
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <linux/joystick.h>
+#include <cstdio>
+#include <cstring>
+#define ZeroMemory(p, size) memset((p), 0, (size))
+#else
 #include <Windows.h>
 #include <Xinput.h>
+#endif
 #include <algorithm>
 #include <limits>
+#include <climits>
+#include <cstdlib>
+#include <chrono>
 
 #define clamp(v, _min, _max) max(min(v, _max), _min)
 
+#ifndef __linux__
 #pragma comment(lib, "Xinput9_1_0.lib")
+#endif
+
+// Steady clock in ms, the same clock the rest of the game profiles with.
+static double nowMs() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
 XINPUT_STATE* Gamepad::getState() { return &gpState; }
 int Gamepad::getIndex() { return gpIndex; }
@@ -16,12 +37,131 @@ void Gamepad::setButtonUpCallback(function<void(button_t)> fn) { buttonUpCallbac
 bool Gamepad::isButtonPressed(button_t b) { return (buttonState & b); }
 void Gamepad::setInvertLStickY(bool b) { invertLSY = b; }
 void Gamepad::setInvertRStickY(bool b) { invertRSY = b; }
+double Gamepad::getLastInputTime() { return lastInputTime; }
+
+#ifdef __linux__
+
+Gamepad::Gamepad(int index) : buttonDownCallback{ nullptr }, buttonUpCallback{ nullptr }, gpIndex{ index }, buttonState{ 0x0 }, connected{ false }, invertLSY{ false }, invertRSY{ false }, lastInputTime{ 0.0 }, running{ true }, linked{ false }, dropped{ 0 }, fd{ -1 } {
+	ZeroMemory(&gpState, sizeof(XINPUT_STATE));
+	char path[32];
+	snprintf(path, sizeof(path), "/dev/input/js%d", gpIndex);
+	// Opened here so 'isConnected()' is right from the first 'update()'.
+	fd = open(path, O_RDONLY | O_NONBLOCK);
+	linked = (fd >= 0);
+	reader = std::thread(&Gamepad::readLoop, this);
+}
+
+Gamepad::~Gamepad() {
+	running = false;
+	if (reader.joinable()) reader.join();
+	if (fd >= 0) close(fd);
+}
+
+// Input thread: blocks on the device, never on the game, and stamps every event as it arrives.
+void Gamepad::readLoop() {
+	char path[32];
+	snprintf(path, sizeof(path), "/dev/input/js%d", gpIndex);
+	js_event js;
+	while (running) {
+		if (fd < 0) {
+			// Unplugged, look for it again every half a second.
+			for (int i{ 0 }; i < 10 && running; ++i) usleep(50000);
+			fd = open(path, O_RDONLY | O_NONBLOCK);
+			linked = (fd >= 0);
+			continue;
+		}
+		// The timeout only bounds how long shutting down takes.
+		pollfd p{ fd, POLLIN, 0 };
+		if (poll(&p, 1, 50) <= 0) continue;
+		bool lost = (p.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+		while (!lost) {
+			ssize_t got = read(fd, &js, sizeof(js));
+			if (got != sizeof(js)) {
+				// errno only means something right after the failing read.
+				lost = (got < 0 && errno == ENODEV);
+				break;
+			}
+			event_t e{ nowMs(), js.value, js.type, js.number };
+			if (!events.push(e)) dropped++;
+		}
+		if (lost) {
+			close(fd);
+			fd = -1;
+			linked = false;
+		}
+	}
+}
+
+// Maps the xpad layout of the joystick interface onto the XInput state.
+void Gamepad::applyEvent(const event_t& e) {
+	static const WORD buttons[] = {
+		XINPUT_GAMEPAD_A, XINPUT_GAMEPAD_B, XINPUT_GAMEPAD_X, XINPUT_GAMEPAD_Y,
+		XINPUT_GAMEPAD_LEFT_SHOULDER, XINPUT_GAMEPAD_RIGHT_SHOULDER,
+		XINPUT_GAMEPAD_BACK, XINPUT_GAMEPAD_START, 0x0,
+		XINPUT_GAMEPAD_LEFT_THUMB, XINPUT_GAMEPAD_RIGHT_THUMB
+	};
+	XINPUT_GAMEPAD& pad = gpState.Gamepad;
+	// Up is negative on the joystick interface and positive on XInput.
+	SHORT flipped = static_cast<SHORT>(clamp(-static_cast<int>(e.value), -SHRT_MAX, SHRT_MAX));
+	BYTE trigger = static_cast<BYTE>((static_cast<int>(e.value) + SHRT_MAX) * 255 / (2 * SHRT_MAX));
+	switch (e.type & ~JS_EVENT_INIT) {
+	case JS_EVENT_BUTTON:
+		if (e.number < sizeof(buttons) / sizeof(buttons[0])) {
+			if (e.value) pad.wButtons |= buttons[e.number];
+			else pad.wButtons &= ~buttons[e.number];
+		}
+		break;
+	case JS_EVENT_AXIS:
+		switch (e.number) {
+		case 0: pad.sThumbLX = e.value; break;
+		case 1: pad.sThumbLY = flipped; break;
+		case 2: pad.bLeftTrigger = trigger; break;
+		case 3: pad.sThumbRX = e.value; break;
+		case 4: pad.sThumbRY = flipped; break;
+		case 5: pad.bRightTrigger = trigger; break;
+		case 6:
+			pad.wButtons &= ~(XINPUT_GAMEPAD_DPAD_LEFT | XINPUT_GAMEPAD_DPAD_RIGHT);
+			if (e.value < 0) pad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
+			else if (e.value > 0) pad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
+			break;
+		case 7:
+			pad.wButtons &= ~(XINPUT_GAMEPAD_DPAD_UP | XINPUT_GAMEPAD_DPAD_DOWN);
+			if (e.value < 0) pad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
+			else if (e.value > 0) pad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
+			break;
+		}
+		break;
+	}
+	++gpState.dwPacketNumber;
+}
+
+void Gamepad::update() {
+	connected = linked;
+	event_t e;
+	while (events.pop(&e)) {
+		applyEvent(e);
+		lastInputTime = e.time;
+	}
+	if (!connected) ZeroMemory(&gpState, sizeof(XINPUT_STATE));
+	dispatchButtons(gpState.Gamepad.wButtons);
+}
+
+#else
 
 void Gamepad::update() {
+	DWORD packet = gpState.dwPacketNumber;
 	ZeroMemory(&gpState, sizeof(XINPUT_STATE));
 	connected = (XInputGetState(gpIndex, &gpState) == ERROR_SUCCESS);
-	if (buttonState != gpState.Gamepad.wButtons) {
-		WORD stateDiff = buttonState ^ gpState.Gamepad.wButtons;
+	// XInput only tells the state changed since the last poll, stamp it now.
+	if (connected && gpState.dwPacketNumber != packet) lastInputTime = nowMs();
+	dispatchButtons(gpState.Gamepad.wButtons);
+}
+
+#endif
+
+void Gamepad::dispatchButtons(WORD buttons) {
+	if (buttonState != buttons) {
+		WORD stateDiff = buttonState ^ buttons;
 		WORD buttonStateCopy = buttonState;
 		for (WORD i{ 0x1 };; i <<= 0x1) {
 			if (stateDiff & 0x1) {
@@ -40,7 +180,7 @@ void Gamepad::update() {
 			}
 		}
 	}
-	buttonState = gpState.Gamepad.wButtons;
+	buttonState = buttons;
 }
 
 vec2 Gamepad::getLStickPosition() {
@@ -80,6 +220,11 @@ float Gamepad::getRTrigger() {
 }
 
 void Gamepad::vibrate(float L, float R) {
+#ifdef __linux__
+	// The joystick interface has no force feedback.
+	(void)L;
+	(void)R;
+#else
 	L = clamp(L, 0.0f, 1.0f);
 	R = clamp(R, 0.0f, 1.0f);
 	XINPUT_VIBRATION vState;
@@ -89,4 +234,5 @@ void Gamepad::vibrate(float L, float R) {
 	vState.wLeftMotorSpeed = iL;
 	vState.wRightMotorSpeed = iR;
 	XInputSetState(gpIndex, &vState);
+#endif
 }
@@ -9,7 +9,49 @@
 #endif
 
 #include <functional>
+#ifdef __linux__
+#include <atomic>
+#include <thread>
+#include "ring_buffer.h"
+
+// The Linux backend reads the joystick interface and fills the same state
+// XInput would, so these mirror the XInput names and values.
+typedef unsigned short WORD;
+typedef unsigned char BYTE;
+typedef short SHORT;
+#define XINPUT_GAMEPAD_DPAD_UP 0x0001
+#define XINPUT_GAMEPAD_DPAD_DOWN 0x0002
+#define XINPUT_GAMEPAD_DPAD_LEFT 0x0004
+#define XINPUT_GAMEPAD_DPAD_RIGHT 0x0008
+#define XINPUT_GAMEPAD_START 0x0010
+#define XINPUT_GAMEPAD_BACK 0x0020
+#define XINPUT_GAMEPAD_LEFT_THUMB 0x0040
+#define XINPUT_GAMEPAD_RIGHT_THUMB 0x0080
+#define XINPUT_GAMEPAD_LEFT_SHOULDER 0x0100
+#define XINPUT_GAMEPAD_RIGHT_SHOULDER 0x0200
+#define XINPUT_GAMEPAD_A 0x1000
+#define XINPUT_GAMEPAD_B 0x2000
+#define XINPUT_GAMEPAD_X 0x4000
+#define XINPUT_GAMEPAD_Y 0x8000
+#define XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE 7849
+#define XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE 8689
+#define XINPUT_GAMEPAD_TRIGGER_THRESHOLD 30
+struct XINPUT_GAMEPAD {
+	WORD wButtons;
+	BYTE bLeftTrigger;
+	BYTE bRightTrigger;
+	SHORT sThumbLX;
+	SHORT sThumbLY;
+	SHORT sThumbRX;
+	SHORT sThumbRY;
+};
+struct XINPUT_STATE {
+	unsigned int dwPacketNumber;
+	XINPUT_GAMEPAD Gamepad;
+};
+#else
 #include <Xinput.h>
+#endif
 using namespace std;
 
 /* The positions of the analog sticks will be returned as 'vec2'.
@@ -45,7 +87,13 @@ public:
 		BACK = XINPUT_GAMEPAD_BACK
 	};
 	// If you have multiple gamepads, create multiple instances of the class using different indexes. The connected gamepads are numbered 0-4. The default argument is 0, meaning this instance will take control of the first (or only one) gamepad connected to the system.
-	Gamepad(int index = 0) : gpIndex{ index }, buttonDownCallback { nullptr }, buttonUpCallback{ nullptr }, buttonState{ 0x0 } {}
+#ifdef __linux__
+	// On Linux this opens /dev/input/js<index> and starts the thread reading it.
+	Gamepad(int index = 0);
+	~Gamepad();
+#else
+	Gamepad(int index = 0) : gpIndex{ index }, buttonDownCallback { nullptr }, buttonUpCallback{ nullptr }, buttonState{ 0x0 }, lastInputTime{ 0.0 } {}
+#endif
 
 	// Set a function (of type 'void', with a 'button_t' argument) to be called each time a button is pressed on the gamepad. The value of the argument should be checked against values of the 'button_t' enum to determine which button was pressed.
 	void setButtonDownCallback(function<void(button_t)> fn);
@@ -76,6 +124,8 @@ public:
 	XINPUT_STATE* getState();
 	// Returns the gamepad's index (the argument the constructor was given). Kind of pointless, but whatever.
 	int getIndex();
+	// Time (steady clock, ms) at which the newest input applied by the last 'update()' happened on the device side.
+	double getLastInputTime();
 private:
 	function<void(button_t)> buttonDownCallback;
 	function<void(button_t)> buttonUpCallback;
@@ -85,4 +135,26 @@ private:
 	bool connected;
 	bool invertLSY;
 	bool invertRSY;
+	double lastInputTime;
+	// Calls the callbacks for every button that changed and keeps the new state.
+	void dispatchButtons(WORD buttons);
+#ifdef __linux__
+	// One joystick event, stamped when the input thread read it.
+	struct event_t {
+		double time;
+		short value;
+		unsigned char type;
+		unsigned char number;
+	};
+	Gamepad(const Gamepad&);
+	Gamepad& operator=(const Gamepad&);
+	void readLoop();
+	void applyEvent(const event_t& e);
+	RingBuffer<event_t, 1024> events;
+	std::thread reader;
+	std::atomic<bool> running;
+	std::atomic<bool> linked;
+	std::atomic<unsigned int> dropped;
+	int fd;
+#endif
 };
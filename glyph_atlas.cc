@@ -0,0 +1,149 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief GlyphAtlas Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "glyph_atlas.h"
+#include "sprite.h"
+
+#include <ESAT_extra/imgui.h>
+
+GlyphAtlas* GlyphAtlas::atlases_[GlyphAtlas::kMaxAtlases];
+unsigned short int GlyphAtlas::num_atlases_ = 0;
+
+/// constructor
+GlyphAtlas::GlyphAtlas() {
+
+  memset(glyphs_, 0, sizeof(glyphs_));
+  texture_ = NULL;
+  memset(font_, 0, 128);
+  ascent_ = 0.0f;
+  size_ = 0;
+  color_[0] = 0;
+  color_[1] = 0;
+  color_[2] = 0;
+}
+
+/**
+ * @brief get the atlas of a font at a size and color, rasterizing it
+ *        the first time it is asked for
+ * @param const char* font, const unsigned short int size,
+ *        const unsigned char* color (rgb)
+ * @return GlyphAtlas* (nullptr when the font can not be rasterized)
+ **/
+GlyphAtlas* GlyphAtlas::Get(const char* font,
+                            const unsigned short int size,
+                            const unsigned char* color) {
+
+  // no context to build it in, texts stay as they are
+  if (Sprite::Headless()){ return nullptr; }
+
+  for (unsigned short int i = 0; i < num_atlases_; i++){
+    GlyphAtlas* atlas = atlases_[i];
+    if (atlas->size_ == size &&
+        atlas->color_[0] == color[0] &&
+        atlas->color_[1] == color[1] &&
+        atlas->color_[2] == color[2] &&
+        !strcmp(atlas->font_, font)){
+      return atlas;
+    }
+  }
+
+  if (num_atlases_ >= kMaxAtlases){ return nullptr; }
+
+  GlyphAtlas* atlas = new GlyphAtlas();
+  if (!atlas->build(font, size, color)){
+    delete atlas;
+    return nullptr;
+  }
+  atlases_[num_atlases_++] = atlas;
+
+  return atlas;
+}
+
+/// release every atlas
+void GlyphAtlas::ReleaseAll() {
+
+  for (unsigned short int i = 0; i < num_atlases_; i++){
+    delete atlases_[i];
+    atlases_[i] = nullptr;
+  }
+  num_atlases_ = 0;
+}
+
+/// rasterize every glyph once into a single texture
+const bool GlyphAtlas::build(const char* font,
+                             const unsigned short int size,
+                             const unsigned char* color) {
+
+  ImFontAtlas atlas;
+  ImFont* im_font = atlas.AddFontFromFileTTF(font, size);
+  if (im_font == NULL){ return false; }
+
+  unsigned char* pixels = NULL;
+  int width = 0;
+  int height = 0;
+  atlas.GetTexDataAsRGBA32(&pixels, &width, &height);
+  if (pixels == NULL){ return false; }
+
+  // bake the color, the glyph coverage stays in the alpha channel
+  for (int i = 0; i < width * height; i++){
+    pixels[i * 4] = color[0];
+    pixels[i * 4 + 1] = color[1];
+    pixels[i * 4 + 2] = color[2];
+  }
+
+  texture_ = ESAT::SpriteFromMemory(width, height, pixels);
+  if (texture_ == NULL){ return false; }
+
+  for (unsigned short int i = 0; i < kNumChars; i++){
+    const ImFont::Glyph* im_glyph = im_font->FindGlyph(kFirstChar + i);
+    if (im_glyph == NULL){ continue; }
+
+    int x = (int)(im_glyph->U0 * width + 0.5f);
+    int y = (int)(im_glyph->V0 * height + 0.5f);
+    int w = (int)((im_glyph->U1 - im_glyph->U0) * width + 0.5f);
+    int h = (int)((im_glyph->V1 - im_glyph->V0) * height + 0.5f);
+
+    glyphs_[i].sprite_ = w > 0 && h > 0 ?
+                         ESAT::SubSprite(texture_, x, y, w, h) : NULL;
+    glyphs_[i].x_offset_ = im_glyph->X0;
+    glyphs_[i].y_offset_ = im_glyph->Y0;
+    glyphs_[i].advance_ = im_glyph->XAdvance;
+  }
+
+  sprintf(font_, "%s", font);
+  ascent_ = im_font->Ascent;
+  size_ = size;
+  color_[0] = color[0];
+  color_[1] = color[1];
+  color_[2] = color[2];
+
+  return true;
+}
+
+/** getters **/
+const Glyph* GlyphAtlas::glyph(const char character) {
+
+  unsigned char index = (unsigned char)character - kFirstChar;
+  if (index >= kNumChars){ return nullptr; }
+
+  return &glyphs_[index];
+}
+
+const float GlyphAtlas::ascent() {
+
+  return ascent_;
+}
+
+/// destructor
+GlyphAtlas::~GlyphAtlas() {
+
+  for (unsigned short int i = 0; i < kNumChars; i++){
+    if (glyphs_[i].sprite_ != NULL){ ESAT::SpriteRelease(glyphs_[i].sprite_); }
+  }
+  if (texture_ != NULL){ ESAT::SpriteRelease(texture_); }
+}
@@ -0,0 +1,79 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief GlyphAtlas Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __GLYPHATLAS_H__
+#define __GLYPHATLAS_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <ESAT/sprite.h>
+
+struct Glyph {
+  ESAT::SpriteHandle sprite_; // NULL for blank glyphs (space)
+  float x_offset_;
+  float y_offset_; // from the top of the line
+  float advance_;
+};
+
+class GlyphAtlas {
+
+  public:
+
+    /**
+     * @brief get the atlas of a font at a size and color, rasterizing it
+     *        the first time it is asked for
+     * @param const char* font, const unsigned short int size,
+     *        const unsigned char* color (rgb)
+     * @return GlyphAtlas* (nullptr when the font can not be rasterized)
+     **/
+    static GlyphAtlas* Get(const char* font,
+                           const unsigned short int size,
+                           const unsigned char* color);
+
+    /// release every atlas
+    static void ReleaseAll();
+
+    /** getters **/
+    const Glyph* glyph(const char character);
+    const float ascent();
+
+    /// public consts
+    static const unsigned char kFirstChar = 32;
+    static const unsigned char kNumChars = 95; // printable ascii
+    static const unsigned short int kMaxAtlases = 8;
+
+  private:
+
+    /// constructor & destructor
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    /// copy constructor
+    GlyphAtlas(const GlyphAtlas& copy);
+    GlyphAtlas operator=(const GlyphAtlas& copy);
+
+    /// rasterize every glyph once into a single texture
+    const bool build(const char* font,
+                     const unsigned short int size,
+                     const unsigned char* color);
+
+    /// private vars
+    Glyph glyphs_[kNumChars];
+    ESAT::SpriteHandle texture_;
+    char font_[128];
+    float ascent_;
+    unsigned short int size_;
+    unsigned char color_[3];
+
+    static GlyphAtlas* atlases_[kMaxAtlases];
+    static unsigned short int num_atlases_;
+};
+
+#endif
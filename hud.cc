@@ -0,0 +1,75 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief HUD Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "hud.h"
+
+/// constructor
+HUDCounter::HUDCounter() {
+
+  memset(buffer_, 0, 48);
+  label_length_ = 0;
+  value_ = 0;
+}
+
+/// init values
+void HUDCounter::init(const char* label,
+                      const unsigned int value,
+                      const gtmath::Point position,
+                      const unsigned short int size,
+                      const gtmath::Vec3 color) {
+
+  label_length_ = snprintf(buffer_, 37, "%s", label);
+  if (label_length_ > 36){ label_length_ = 36; }
+  value_ = value;
+
+  text_.init("", position, size, color);
+  format();
+}
+
+/// write label_ and value_ into buffer_ and hand it to text_
+void HUDCounter::format() {
+
+  char digits[10];
+  unsigned short int num_digits = 0;
+  unsigned int value = value_;
+
+  do {
+    digits[num_digits++] = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+
+  char* cursor = buffer_ + label_length_;
+  while (num_digits > 0){ *cursor++ = digits[--num_digits]; }
+  *cursor = '\0';
+
+  text_.set_text(buffer_);
+}
+
+/// draw on screen
+void HUDCounter::render() {
+
+  text_.render();
+}
+
+/** setters **/
+void HUDCounter::set_value(const unsigned int value) {
+
+  if (value == value_){ return; }
+
+  value_ = value;
+  format();
+}
+
+/** getters **/
+const unsigned int HUDCounter::value() {
+
+  return value_;
+}
+
+/// destructor
+HUDCounter::~HUDCounter() {}
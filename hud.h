@@ -0,0 +1,60 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief HUD Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __HUD_H__
+#define __HUD_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtmath.h"
+#include "text.h"
+
+/// label followed by a number, only re-laid out when the number changes
+class HUDCounter {
+
+  public:
+
+    /// constructor & destructor
+    HUDCounter();
+    ~HUDCounter();
+
+    /// init values
+    void init(const char* label,
+              const unsigned int value,
+              const gtmath::Point position,
+              const unsigned short int size = 25,
+              const gtmath::Vec3 color = { 255.0f, 255.0f, 255.0f });
+
+    /// draw on screen
+    void render();
+
+    /** setters **/
+    void set_value(const unsigned int value);
+
+    /** getters **/
+    const unsigned int value();
+
+  private:
+
+    /// copy constructor
+    HUDCounter(const HUDCounter& copy);
+    HUDCounter operator=(const HUDCounter& copy);
+
+    /// write label_ and value_ into buffer_ and hand it to text_
+    void format();
+
+    /// private vars
+    Text text_;
+    char buffer_[48]; // label plus up to 10 digits
+    unsigned short int label_length_;
+    unsigned int value_;
+};
+
+#endif
@@ -0,0 +1,256 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief JobSystem Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "job_system.h"
+
+/// queue of the running thread, 0 for every thread that is not a worker
+static thread_local unsigned short int t_queue = 0;
+
+/// constructor
+JobSystem::JobSystem() : queued_(0), is_running_(true) {
+
+  for (unsigned short int i = 0; i <= kMaxWorkers; i++){
+    queues_[i].top_ = 0;
+    queues_[i].bottom_ = 0;
+  }
+
+  unsigned int cores = std::thread::hardware_concurrency();
+  num_workers_ = cores > 1 ? cores - 1 : 0;
+  if (num_workers_ > kMaxWorkers){ num_workers_ = kMaxWorkers; }
+
+  for (unsigned short int i = 0; i < num_workers_; i++){
+    workers_[i] = std::thread(&JobSystem::workerLoop, this, i + 1);
+  }
+}
+
+/// singleton, starts one worker per spare core
+JobSystem& JobSystem::instance() {
+
+  static JobSystem* singleton = new JobSystem();
+  return *singleton;
+}
+
+/**
+ * @brief queue a job on the calling thread, idle workers steal it
+ * @param const Job& job
+ * @return void
+ **/
+void JobSystem::run(const Job& job) {
+
+  if (job.counter_ != nullptr){ job.counter_->pending_++; }
+
+  // a full queue runs the job right away
+  if (!push(t_queue, job)){
+    if (job.after_ != nullptr){ wait(job.after_); }
+    execute(job);
+    return;
+  }
+
+  wakeWorkers();
+}
+
+/**
+ * @brief split [0, count) in jobs of grain items and queue them
+ * @param JobFunction function, void* data, const unsigned int count,
+ *        const unsigned int grain, JobCounter* counter,
+ *        const JobCounter* after (nullptr when it has no dependency)
+ * @return void
+ **/
+void JobSystem::parallelFor(JobFunction function,
+                            void* data,
+                            const unsigned int count,
+                            const unsigned int grain,
+                            JobCounter* counter,
+                            const JobCounter* after) {
+
+  const unsigned int step = grain > 0 ? grain : 1;
+
+  Job job;
+  job.function_ = function;
+  job.data_ = data;
+  job.counter_ = counter;
+  job.after_ = after;
+
+  for (unsigned int first = 0; first < count; first += step){
+    job.first_ = first;
+    job.last_ = first + step < count ? first + step : count;
+    if (counter != nullptr){ counter->pending_++; }
+    if (!push(t_queue, job)){
+      if (after != nullptr){ wait(after); }
+      execute(job);
+    }
+  }
+
+  wakeWorkers();
+}
+
+/**
+ * @brief run queued jobs of the counter until it is done; jobs of
+ *        other batches are left to the workers, so a frame never ends
+ *        up running an unrelated long job while it waits
+ * @param const JobCounter* counter
+ * @return void
+ **/
+void JobSystem::wait(const JobCounter* counter) {
+
+  Job job;
+  while (counter->pending_.load() > 0){
+    if (findJob(t_queue, &job, counter)){ execute(job); }
+    else { std::this_thread::yield(); }
+  }
+}
+
+/// join every worker, on shutdown
+void JobSystem::shutdown() {
+
+  if (!is_running_.exchange(false)){ return; }
+
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    wake_.notify_all();
+  }
+  for (unsigned short int i = 0; i < num_workers_; i++){
+    workers_[i].join();
+  }
+  num_workers_ = 0;
+}
+
+/** queues **/
+const bool JobSystem::push(const unsigned short int queue, const Job& job) {
+
+  JobQueue& q = queues_[queue];
+  std::lock_guard<std::mutex> lock(q.mutex_);
+
+  if (q.top_ - q.bottom_ >= kQueueSize){ return false; }
+
+  q.jobs_[q.top_ & (kQueueSize - 1)] = job;
+  q.top_++;
+  queued_++;
+
+  return true;
+}
+
+const bool JobSystem::pop(const unsigned short int queue, Job* job) {
+
+  JobQueue& q = queues_[queue];
+  std::lock_guard<std::mutex> lock(q.mutex_);
+
+  if (q.top_ == q.bottom_){ return false; }
+
+  q.top_--;
+  *job = q.jobs_[q.top_ & (kQueueSize - 1)];
+  queued_--;
+
+  return true;
+}
+
+const bool JobSystem::steal(const unsigned short int queue, Job* job) {
+
+  JobQueue& q = queues_[queue];
+  std::lock_guard<std::mutex> lock(q.mutex_);
+
+  if (q.top_ == q.bottom_){ return false; }
+
+  *job = q.jobs_[q.bottom_ & (kQueueSize - 1)];
+  q.bottom_++;
+  queued_--;
+
+  return true;
+}
+
+/// a job of the counter, wherever it sits in the queue
+const bool JobSystem::take(const unsigned short int queue,
+                           const JobCounter* counter,
+                           Job* job) {
+
+  JobQueue& q = queues_[queue];
+  std::lock_guard<std::mutex> lock(q.mutex_);
+
+  // newest first, the top one fills the hole so the queue stays packed
+  for (unsigned int i = q.top_; i != q.bottom_;){
+    i--;
+    if (q.jobs_[i & (kQueueSize - 1)].counter_ != counter){ continue; }
+    *job = q.jobs_[i & (kQueueSize - 1)];
+    q.top_--;
+    q.jobs_[i & (kQueueSize - 1)] = q.jobs_[q.top_ & (kQueueSize - 1)];
+    queued_--;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief own queue first, then the others, false when none is runnable
+ * @param const unsigned short int queue, Job* job,
+ *        const JobCounter* counter (only its jobs, nullptr for any)
+ * @return const bool
+ **/
+const bool JobSystem::findJob(const unsigned short int queue,
+                              Job* job,
+                              const JobCounter* counter) {
+
+  bool found = counter == nullptr ? pop(queue, job) :
+                                    take(queue, counter, job);
+  for (unsigned short int i = 1; !found && i <= num_workers_; i++){
+    const unsigned short int other = (queue + i) % (num_workers_ + 1);
+    found = counter == nullptr ? steal(other, job) :
+                                 take(other, counter, job);
+  }
+  if (!found){ return false; }
+
+  // its dependency is still queued or running, help finishing it first
+  if (job->after_ != nullptr){ wait(job->after_); }
+
+  return true;
+}
+
+/// a worker about to sleep has either seen the new jobs or gets notified
+void JobSystem::wakeWorkers() {
+
+  if (num_workers_ == 0){ return; }
+
+  { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+  wake_.notify_all();
+}
+
+void JobSystem::execute(const Job& job) {
+
+  job.function_(job.data_, job.first_, job.last_);
+  if (job.counter_ != nullptr){ job.counter_->pending_--; }
+}
+
+void JobSystem::workerLoop(const unsigned short int queue) {
+
+  t_queue = queue;
+
+  Job job;
+  while (is_running_.load()){
+    if (findJob(queue, &job)){
+      execute(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_.wait(lock, [this]{
+      return queued_.load() > 0 || !is_running_.load();
+    });
+  }
+}
+
+/** getters **/
+const unsigned short int JobSystem::numWorkers() {
+
+  return num_workers_;
+}
+
+/// destructor
+JobSystem::~JobSystem() {
+
+  shutdown();
+}
@@ -0,0 +1,137 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief JobSystem Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __JOBSYSTEM_H__
+#define __JOBSYSTEM_H__ 1
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define JOBSYSTEM JobSystem::instance()
+
+/// works on the items [first, last) of data
+typedef void (*JobFunction)(void* data,
+                            const unsigned int first,
+                            const unsigned int last);
+
+/// jobs of a batch still to finish, zero when done
+struct JobCounter {
+  JobCounter() : pending_(0) {}
+  std::atomic<unsigned int> pending_;
+};
+
+struct Job {
+  JobFunction function_;
+  void* data_;
+  unsigned int first_;
+  unsigned int last_;
+  JobCounter* counter_; // decremented once the job is done
+  const JobCounter* after_; // has to be done before the job starts
+};
+
+class JobSystem {
+
+  public:
+
+    /// singleton, starts one worker per spare core
+    static JobSystem& instance();
+
+    /**
+     * @brief queue a job on the calling thread, idle workers steal it
+     * @param const Job& job
+     * @return void
+     **/
+    void run(const Job& job);
+
+    /**
+     * @brief split [0, count) in jobs of grain items and queue them
+     * @param JobFunction function, void* data, const unsigned int count,
+     *        const unsigned int grain, JobCounter* counter,
+     *        const JobCounter* after (nullptr when it has no dependency)
+     * @return void
+     **/
+    void parallelFor(JobFunction function,
+                     void* data,
+                     const unsigned int count,
+                     const unsigned int grain,
+                     JobCounter* counter,
+                     const JobCounter* after = nullptr);
+
+    /**
+     * @brief run queued jobs of the counter until it is done; jobs of
+     *        other batches are left to the workers, so a frame never ends
+     *        up running an unrelated long job while it waits
+     * @param const JobCounter* counter
+     * @return void
+     **/
+    void wait(const JobCounter* counter);
+
+    /// join every worker, on shutdown
+    void shutdown();
+
+    /** getters **/
+    const unsigned short int numWorkers();
+
+    /// public consts
+    static const unsigned short int kMaxWorkers = 15;
+    static const unsigned int kQueueSize = 1024; // power of two
+
+  private:
+
+    /// one per worker plus one shared by every other thread
+    struct JobQueue {
+      std::mutex mutex_;
+      Job jobs_[kQueueSize];
+      unsigned int top_; // the owner pushes and pops here
+      unsigned int bottom_; // thieves take from here
+    };
+
+    /// constructor & destructor
+    JobSystem();
+    ~JobSystem();
+
+    /// copy constructor
+    JobSystem(const JobSystem& copy);
+    JobSystem operator=(const JobSystem& copy);
+
+    /** queues **/
+    const bool push(const unsigned short int queue, const Job& job);
+    const bool pop(const unsigned short int queue, Job* job);
+    const bool steal(const unsigned short int queue, Job* job);
+    /// a job of the counter, wherever it sits in the queue
+    const bool take(const unsigned short int queue,
+                    const JobCounter* counter,
+                    Job* job);
+
+    /**
+     * @brief own queue first, then the others, false when none is runnable
+     * @param const unsigned short int queue, Job* job,
+     *        const JobCounter* counter (only its jobs, nullptr for any)
+     * @return const bool
+     **/
+    const bool findJob(const unsigned short int queue,
+                       Job* job,
+                       const JobCounter* counter = nullptr);
+
+    void wakeWorkers();
+    void execute(const Job& job);
+    void workerLoop(const unsigned short int queue);
+
+    /// private vars
+    JobQueue queues_[kMaxWorkers + 1];
+    std::thread workers_[kMaxWorkers];
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<unsigned int> queued_;
+    std::atomic<bool> is_running_;
+    unsigned short int num_workers_;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief LatencyTracker Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "latency_tracker.h"
+
+const float LatencyTracker::kBucketMs = 0.5f;
+
+/// constructor
+LatencyTracker::LatencyTracker() {
+
+  next_sequence_ = 1; // 0 means no input
+  reset();
+}
+
+/// singleton
+LatencyTracker& LatencyTracker::instance() {
+
+  static LatencyTracker* singleton = new LatencyTracker();
+  return *singleton;
+}
+
+/**
+ * @brief start measuring an input change
+ * @param const double time (ms, Profiler clock)
+ * @return const unsigned int the sequence id the frame has to carry
+ **/
+const unsigned int LatencyTracker::sample(const double time) {
+
+  // no frame made it out for a while, the oldest is lost
+  if (num_pending_ == kMaxPending){
+    first_pending_ = (first_pending_ + 1) % kMaxPending;
+    num_pending_--;
+    dropped_++;
+  }
+
+  LatencySample& sample =
+    pending_[(first_pending_ + num_pending_) % kMaxPending];
+  sample.sequence_ = next_sequence_++;
+  sample.time_ = time;
+  num_pending_++;
+
+  return sample.sequence_;
+}
+
+/**
+ * @brief a frame carrying a sequence id has been submitted, every input
+ *        up to that id is now on screen
+ * @param const unsigned int sequence, const double time (ms)
+ * @return void
+ **/
+void LatencyTracker::submit(const unsigned int sequence, const double time) {
+
+  while (num_pending_ > 0 && pending_[first_pending_].sequence_ <= sequence){
+    double latency = time - pending_[first_pending_].time_;
+    if (latency < 0.0){ latency = 0.0; }
+
+    unsigned int bucket = (unsigned int)(latency / kBucketMs);
+    if (bucket > kNumBuckets){ bucket = kNumBuckets; }
+    buckets_[bucket]++;
+    count_++;
+    if (latency > peak_){ peak_ = latency; }
+
+    first_pending_ = (first_pending_ + 1) % kMaxPending;
+    num_pending_--;
+  }
+}
+
+/**
+ * @brief latency under which a fraction of the samples are
+ * @param const float fraction (0.5 for the median)
+ * @return const double ms, upper bound of the bucket
+ **/
+const double LatencyTracker::percentile(const float fraction) {
+
+  if (count_ == 0){ return 0.0; }
+
+  const unsigned int target = (unsigned int)(fraction * count_ + 0.5f);
+  unsigned int accumulated = 0;
+  for (unsigned short int i = 0; i < kNumBuckets; i++){
+    accumulated += buckets_[i];
+    if (accumulated >= target && accumulated > 0){
+      const double upper = (i + 1) * kBucketMs;
+      return upper < peak_ ? upper : peak_;
+    }
+  }
+
+  return peak_;
+}
+
+/// one line summary, for logs and benches
+void LatencyTracker::report(FILE* out) {
+
+  fprintf(out, "input latency: %u samples, p50 %.1f ms, p95 %.1f ms, "
+          "p99 %.1f ms, max %.1f ms, dropped %u\n", count_,
+          percentile(0.5f), percentile(0.95f), percentile(0.99f), peak_,
+          dropped_);
+}
+
+/// forget every measure
+void LatencyTracker::reset() {
+
+  memset(buckets_, 0, sizeof(buckets_));
+  first_pending_ = 0;
+  num_pending_ = 0;
+  count_ = 0;
+  dropped_ = 0;
+  peak_ = 0.0;
+}
+
+/** getters **/
+const unsigned int LatencyTracker::count() {
+
+  return count_;
+}
+
+const double LatencyTracker::peak() {
+
+  return peak_;
+}
+
+const unsigned int LatencyTracker::dropped() {
+
+  return dropped_;
+}
+
+/// destructor
+LatencyTracker::~LatencyTracker() {}
@@ -0,0 +1,89 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief LatencyTracker Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __LATENCYTRACKER_H__
+#define __LATENCYTRACKER_H__ 1
+
+#include <stdio.h>
+#include <string.h>
+
+#define LATENCY LatencyTracker::instance()
+
+/// an input change waiting for the frame that shows it
+struct LatencySample {
+  unsigned int sequence_;
+  double time_; // ms, when the input happened
+};
+
+/// input to frame submission latency, all on the main thread
+class LatencyTracker {
+
+  public:
+
+    static const unsigned short int kMaxPending = 64;
+    static const unsigned short int kNumBuckets = 200;
+    static const float kBucketMs; // width of a histogram bucket
+
+    /// singleton
+    static LatencyTracker& instance();
+
+    /**
+     * @brief start measuring an input change
+     * @param const double time (ms, Profiler clock)
+     * @return const unsigned int the sequence id the frame has to carry
+     **/
+    const unsigned int sample(const double time);
+
+    /**
+     * @brief a frame carrying a sequence id has been submitted, every input
+     *        up to that id is now on screen
+     * @param const unsigned int sequence, const double time (ms)
+     * @return void
+     **/
+    void submit(const unsigned int sequence, const double time);
+
+    /**
+     * @brief latency under which a fraction of the samples are
+     * @param const float fraction (0.5 for the median)
+     * @return const double ms, upper bound of the bucket
+     **/
+    const double percentile(const float fraction);
+
+    /// one line summary, for logs and benches
+    void report(FILE* out);
+
+    /// forget every measure
+    void reset();
+
+    /** getters **/
+    const unsigned int count();
+    const double peak();
+    const unsigned int dropped();
+
+  private:
+
+    /// constructor & destructor
+    LatencyTracker();
+    ~LatencyTracker();
+
+    /// copy constructor
+    LatencyTracker(const LatencyTracker& copy);
+    LatencyTracker operator=(const LatencyTracker& copy);
+
+    /// private vars
+    LatencySample pending_[kMaxPending]; // ring, oldest first
+    unsigned short int first_pending_;
+    unsigned short int num_pending_;
+    unsigned int next_sequence_;
+    unsigned int buckets_[kNumBuckets + 1]; // the last one is overflow
+    unsigned int count_;
+    unsigned int dropped_; // samples pushed out before their frame
+    double peak_;
+};
+
+#endif
@@ -0,0 +1,271 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief LevelGenerator Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "level_generator.h"
+
+#include <algorithm>
+
+/// xorshift, the same sequence on every platform unlike rand()
+static unsigned int NextRandom(unsigned int* state) {
+
+  unsigned int x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+
+  return x;
+}
+
+/// [0, 1)
+static float RandomFloat(unsigned int* state) {
+
+  return (NextRandom(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+/// a kind from 1 to kNumBrickKinds, following the spec weights
+static unsigned short int PickKind(const LevelSpec& spec,
+                                   unsigned int* state) {
+
+  float total = 0.0f;
+  for (unsigned short int i = 0; i < kNumBrickKinds; i++){
+    if (spec.kinds_[i] > 0.0f){ total += spec.kinds_[i]; }
+  }
+  if (total <= 0.0f){ return 1 + NextRandom(state) % kNumBrickKinds; }
+
+  float pick = RandomFloat(state) * total;
+  for (unsigned short int i = 0; i < kNumBrickKinds; i++){
+    if (spec.kinds_[i] <= 0.0f){ continue; }
+    if (pick < spec.kinds_[i]){ return i + 1; }
+    pick -= spec.kinds_[i];
+  }
+
+  return kNumBrickKinds;
+}
+
+/// every cell with a brick gets its kind
+static void PaintKinds(const LevelSpec& spec,
+                       unsigned int* state,
+                       std::vector<unsigned short int>* cells) {
+
+  for (unsigned int i = 0; i < cells->size(); i++){
+    if ((*cells)[i] != 0){ (*cells)[i] = PickKind(spec, state); }
+  }
+}
+
+/// value noise over a coarse lattice, the lowest cells get the bricks
+static void GenerateNoise(const LevelSpec& spec,
+                          unsigned int* state,
+                          std::vector<unsigned short int>* cells) {
+
+  const unsigned short int kLatticeStep = 8; // cells between lattice points
+  const unsigned int lattice_cols = spec.cols_ / kLatticeStep + 2;
+  const unsigned int lattice_rows = spec.rows_ / kLatticeStep + 2;
+  const unsigned int num_cells = (unsigned int)spec.cols_ * spec.rows_;
+
+  std::vector<float> lattice(lattice_cols * lattice_rows);
+  for (unsigned int i = 0; i < lattice.size(); i++){
+    lattice[i] = RandomFloat(state);
+  }
+
+  std::vector<float> field(num_cells);
+  for (unsigned int row = 0; row < spec.rows_; row++){
+    const float fy = (float)row / kLatticeStep;
+    const unsigned int iy = (unsigned int)fy;
+    const float ty = (fy - iy) * (fy - iy) * (3.0f - 2.0f * (fy - iy));
+    for (unsigned int col = 0; col < spec.cols_; col++){
+      const float fx = (float)col / kLatticeStep;
+      const unsigned int ix = (unsigned int)fx;
+      const float tx = (fx - ix) * (fx - ix) * (3.0f - 2.0f * (fx - ix));
+      const float* top = &lattice[iy * lattice_cols + ix];
+      const float* bottom = top + lattice_cols;
+      const float up = top[0] + (top[1] - top[0]) * tx;
+      const float down = bottom[0] + (bottom[1] - bottom[0]) * tx;
+      field[row * spec.cols_ + col] = up + (down - up) * ty;
+    }
+  }
+
+  // the threshold that leaves exactly density of the cells below it
+  const unsigned int bricks = (unsigned int)(spec.density_ * num_cells);
+  if (bricks == 0){ return; }
+  float threshold = 2.0f;
+  if (bricks < num_cells){
+    std::vector<float> sorted(field);
+    std::nth_element(sorted.begin(), sorted.begin() + bricks, sorted.end());
+    threshold = sorted[bricks];
+  }
+
+  for (unsigned int i = 0; i < num_cells; i++){
+    if (field[i] < threshold){ (*cells)[i] = 1; }
+  }
+  PaintKinds(spec, state, cells);
+}
+
+/// the left half at random, the right half its mirror
+static void GenerateSymmetric(const LevelSpec& spec,
+                              unsigned int* state,
+                              std::vector<unsigned short int>* cells) {
+
+  const unsigned short int half = (spec.cols_ + 1) / 2;
+
+  for (unsigned int row = 0; row < spec.rows_; row++){
+    unsigned short int* line = &(*cells)[row * spec.cols_];
+    for (unsigned short int col = 0; col < half; col++){
+      if (RandomFloat(state) >= spec.density_){ continue; }
+      const unsigned short int kind = PickKind(spec, state);
+      line[col] = kind;
+      line[spec.cols_ - 1 - col] = kind;
+    }
+  }
+}
+
+/**
+ * walls of a maze carved from the odd cells (iterative backtracker), then
+ * random walls removed until the density is met; a maze keeps about half
+ * of the cells as walls, so that is the highest density it reaches
+ **/
+static void GenerateMaze(const LevelSpec& spec,
+                         unsigned int* state,
+                         std::vector<unsigned short int>* cells) {
+
+  const unsigned short int cols = spec.cols_;
+  const unsigned short int rows = spec.rows_;
+  const unsigned int num_cells = (unsigned int)cols * rows;
+
+  std::fill(cells->begin(), cells->end(), 1);
+
+  if (cols >= 3 && rows >= 3){
+    const int kSteps[4][2] = { { 2, 0 }, { -2, 0 }, { 0, 2 }, { 0, -2 } };
+    std::vector<unsigned int> stack;
+    stack.reserve(num_cells / 4 + 1);
+    (*cells)[cols + 1] = 0;
+    stack.push_back(cols + 1);
+
+    while (!stack.empty()){
+      const unsigned int current = stack.back();
+      const int col = current % cols;
+      const int row = current / cols;
+
+      // walls still standing around the current cell
+      unsigned int options[4];
+      unsigned short int num_options = 0;
+      for (unsigned short int i = 0; i < 4; i++){
+        const int next_col = col + kSteps[i][0];
+        const int next_row = row + kSteps[i][1];
+        if (next_col < 1 || next_col > cols - 2 ||
+            next_row < 1 || next_row > rows - 2){
+          continue;
+        }
+        if ((*cells)[next_row * cols + next_col] != 0){
+          options[num_options++] = i;
+        }
+      }
+      if (num_options == 0){
+        stack.pop_back();
+        continue;
+      }
+
+      const unsigned int step = options[NextRandom(state) % num_options];
+      const int next_col = col + kSteps[step][0];
+      const int next_row = row + kSteps[step][1];
+      (*cells)[(row + next_row) / 2 * cols + (col + next_col) / 2] = 0;
+      (*cells)[next_row * cols + next_col] = 0;
+      stack.push_back(next_row * cols + next_col);
+    }
+  }
+
+  // open the maze up, a shuffled prefix of the walls goes
+  std::vector<unsigned int> walls;
+  for (unsigned int i = 0; i < num_cells; i++){
+    if ((*cells)[i] != 0){ walls.push_back(i); }
+  }
+  const unsigned int target = (unsigned int)(spec.density_ * num_cells);
+  if (walls.size() > target){
+    const unsigned int remove = (unsigned int)walls.size() - target;
+    for (unsigned int i = 0; i < remove; i++){
+      const unsigned int pick = i + NextRandom(state) % (walls.size() - i);
+      std::swap(walls[i], walls[pick]);
+      (*cells)[walls[i]] = 0;
+    }
+  }
+  PaintKinds(spec, state, cells);
+}
+
+/**
+ * @brief a spec with about that many bricks, on a grid as wide as the
+ *        original levels are (10:7) and an even kind mix
+ * @param const unsigned int bricks, const unsigned int seed,
+ *        const LevelPattern pattern, const float density
+ * @return LevelSpec
+ **/
+LevelSpec LevelSpecForBricks(const unsigned int bricks,
+                             const unsigned int seed,
+                             const LevelPattern pattern,
+                             const float density) {
+
+  LevelSpec spec;
+  spec.seed_ = seed;
+  spec.pattern_ = pattern;
+  spec.density_ = density > 0.01f ? (density < 1.0f ? density : 1.0f) :
+                                    0.01f;
+  // a maze can't hold more than about half of its cells
+  if (pattern == kLevelPattern_Maze && spec.density_ > 0.5f){
+    spec.density_ = 0.5f;
+  }
+  for (unsigned short int i = 0; i < kNumBrickKinds; i++){
+    spec.kinds_[i] = 0.0f;
+  }
+
+  const float cells = bricks / spec.density_;
+  float cols = floor(sqrt(cells * 10.0f / 7.0f) + 0.5f);
+  if (cols < 1.0f){ cols = 1.0f; }
+  if (cols > 65535.0f){ cols = 65535.0f; }
+  float rows = ceil(cells / cols);
+  if (rows < 1.0f){ rows = 1.0f; }
+  if (rows > 65535.0f){ rows = 65535.0f; }
+  spec.cols_ = (unsigned short int)cols;
+  spec.rows_ = (unsigned short int)rows;
+
+  return spec;
+}
+
+/**
+ * @brief fill cells (cols * rows, row major) with brick kinds, 0 gaps
+ * @param const LevelSpec& spec, std::vector<unsigned short int>* cells
+ * @return void
+ **/
+void GenerateLevel(const LevelSpec& spec,
+                   std::vector<unsigned short int>* cells) {
+
+  cells->assign((unsigned int)spec.cols_ * spec.rows_, 0);
+
+  // a zero state would stay zero
+  unsigned int state = spec.seed_ * 2654435761u + 0x9E3779B9u;
+  if (state == 0){ state = 1; }
+
+  switch (spec.pattern_){
+    case kLevelPattern_Noise: { GenerateNoise(spec, &state, cells); } break;
+    case kLevelPattern_Symmetric: {
+      GenerateSymmetric(spec, &state, cells);
+    } break;
+    case kLevelPattern_Maze: { GenerateMaze(spec, &state, cells); } break;
+    default: break;
+  }
+}
+
+/** getters **/
+const char* LevelPatternName(const LevelPattern pattern) {
+
+  const char* kNames[kLevelPattern_Count] = {
+    "Noise",
+    "Symmetric",
+    "Maze"
+  };
+
+  return pattern < kLevelPattern_Count ? kNames[pattern] : "None";
+}
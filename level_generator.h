@@ -0,0 +1,57 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief LevelGenerator Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __LEVELGENERATOR_H__
+#define __LEVELGENERATOR_H__ 1
+
+#include <math.h>
+#include <vector>
+
+static const unsigned short int kNumBrickKinds = 7;
+
+static enum LevelPattern {
+  kLevelPattern_Noise = 0, // smooth blobs
+  kLevelPattern_Symmetric, // random left half, mirrored
+  kLevelPattern_Maze, // maze walls, opened up to the density
+  kLevelPattern_Count
+};
+
+/// everything a generated level depends on, same spec same level
+struct LevelSpec {
+  unsigned int seed_;
+  unsigned short int cols_;
+  unsigned short int rows_;
+  float density_; // share of cells with a brick, 0 to 1
+  LevelPattern pattern_;
+  float kinds_[kNumBrickKinds]; // weight of every kind, all 0 = even mix
+};
+
+/**
+ * @brief a spec with about that many bricks, on a grid as wide as the
+ *        original levels are (10:7) and an even kind mix
+ * @param const unsigned int bricks, const unsigned int seed,
+ *        const LevelPattern pattern, const float density
+ * @return LevelSpec
+ **/
+LevelSpec LevelSpecForBricks(const unsigned int bricks,
+                             const unsigned int seed,
+                             const LevelPattern pattern,
+                             const float density = 0.6f);
+
+/**
+ * @brief fill cells (cols * rows, row major) with brick kinds, 0 gaps
+ * @param const LevelSpec& spec, std::vector<unsigned short int>* cells
+ * @return void
+ **/
+void GenerateLevel(const LevelSpec& spec,
+                   std::vector<unsigned short int>* cells);
+
+/** getters **/
+const char* LevelPatternName(const LevelPattern pattern);
+
+#endif
@@ -21,6 +21,26 @@ void LuaWrapper::init(const char* path) {
   if (luaL_dofile(LUA_, path)){ printf("ERROR en Lua\n"); }
 }
 
+/**
+ * @brief run one more file on the same state, its globals win
+ * @param const char* path
+ * @return const bool false when it is missing or fails
+ **/
+const bool LuaWrapper::loadFile(const char* path) {
+
+  FILE* file = fopen(path, "r");
+  if (file == NULL){ return false; }
+  fclose(file);
+
+  if (luaL_dofile(LUA_, path)){
+    printf("ERROR en Lua: %s\n", lua_tostring(LUA_, -1));
+    lua_pop(LUA_, 1);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * @brief register a function / call the function
  * @param const char* lua_function, lua_CFunction cfunction / none
@@ -173,6 +193,28 @@ const bool LuaWrapper::getBooleanFromTableByIndex(const char* table,
   return boolean;
 }
 
+/**
+ * @brief insert table from lua file to the stack, read count integers
+ *        by index from first on and pop it; missing ones are 0
+ * @param const char* table, const unsigned int first,
+ *        const unsigned int count, unsigned short int* values
+ * @return void
+ **/
+void LuaWrapper::getIntegersFromTableByIndex(const char* table,
+                                             const unsigned int first,
+                                             const unsigned int count,
+                                             unsigned short int* values) {
+
+  lua_checkstack(LUA_, 2);
+  lua_getglobal(LUA_, table);
+  for (unsigned int i = 0; i < count; i++){
+    lua_rawgeti(LUA_, -1, first + i + 1);
+    values[i] = (unsigned short int)lua_tointeger(LUA_, -1);
+    lua_pop(LUA_, 1);
+  }
+  lua_pop(LUA_, 1);
+}
+
 /** releasers **/
 void LuaWrapper::pop(const unsigned short int num_elements) {
 
@@ -26,6 +26,13 @@ class LuaWrapper {
 
     /// init values
     void init(const char* path);
+
+    /**
+     * @brief run one more file on the same state, its globals win
+     * @param const char* path
+     * @return const bool false when it is missing or fails
+     **/
+    const bool loadFile(const char* path);
     /**
      *
      *  this is like the lua stack works (LIFO):
@@ -89,6 +96,18 @@ class LuaWrapper {
     const bool getBooleanFromTableByIndex(const char* table,
                                           const short int index);
 
+    /**
+     * @brief insert table from lua file to the stack, read count integers
+     *        by index from first on and pop it; missing ones are 0
+     * @param const char* table, const unsigned int first,
+     *        const unsigned int count, unsigned short int* values
+     * @return void
+     **/
+    void getIntegersFromTableByIndex(const char* table,
+                                     const unsigned int first,
+                                     const unsigned int count,
+                                     unsigned short int* values);
+
     /** releasers **/
     void pop(const unsigned short int num_elements);
     void remove(const short int index);
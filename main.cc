@@ -8,8 +8,11 @@
  **/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <chrono>
+#include <thread>
 
 #include <ESAT/window.h>
 #include <ESAT/input.h>
@@ -18,6 +21,14 @@
 #include "lua.hpp"
 #include "luawrapper.h"
 #include "game_manager.h"
+#include "audio_manager.h"
+#include "glyph_atlas.h"
+#include "render_queue.h"
+#include "frame_thread.h"
+#include "job_system.h"
+#include "latency_tracker.h"
+#include "alloc_tracker.h"
+#include "chipmunk_alloc.h"
 
 #define GAMEMANAGER GameManager::instance()
 
@@ -40,8 +51,113 @@ void LuaConfig(){
   }
 }
 
+/// simulation side of a frame, drawn by the next present
+void SimulateFrame(void* data){
+
+  const double delta_time = *(double*)data;
+
+  GAMEMANAGER.engine_scene_->update(delta_time);
+  GAMEMANAGER.engine_scene_->render();
+}
+
+/// allocation counters roll over once the frame is completely done
+void EndFrame(){
+
+  AllocNewFrame();
+  ChipmunkAllocNewFrame();
+}
+
+/**
+ * @brief play without a window on a fixed step with the autopilot, and
+ *        check that steady frames (not close to a level or status change)
+ *        allocate nothing; audio is left out, SoLoud makes an instance
+ *        per voice played
+ * @param const unsigned int frames
+ * @return int 1 when a steady frame allocated
+ **/
+int RunHeadless(const unsigned int frames){
+
+  const unsigned int kWarmupFrames = 120;
+  const unsigned int kSettleFrames = 10;
+  const unsigned int kMaxReports = 20;
+
+  GAMEMANAGER.headless_ = true;
+  Sprite::SetHeadless(true);
+  LuaConfig();
+  EngineScene* scene = GAMEMANAGER.engine_scene_;
+  scene->init();
+  while (!AUDIOMANAGER.ready()){
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EndFrame();
+
+  static double frame_delta = 1000.0 / 60.0;
+  GameStatus status = scene->gameStatus();
+  unsigned short int level = scene->currentLevel();
+  unsigned int settled = 0;
+  unsigned int steady = 0;
+  unsigned int failed = 0;
+  unsigned int audio = 0;
+
+  for (unsigned int frame = 0; frame < frames; frame++){
+    scene->autopilot();
+    SimulateFrame(&frame_delta);
+    RENDERQUEUE.swap();
+    // nothing is presented, the frame is out once it is swapped
+    LATENCY.submit(RENDERQUEUE.swappedSequence(), Profiler::Now());
+    EndFrame();
+
+    if (scene->gameStatus() != status || scene->currentLevel() != level){
+      status = scene->gameStatus();
+      level = scene->currentLevel();
+      settled = 0;
+    }
+    else { settled++; }
+    audio += AllocLastFrame(kAllocTag_Audio).allocs_;
+    if (frame < kWarmupFrames || settled < kSettleFrames){ continue; }
+
+    steady++;
+    const unsigned int physics = ChipmunkAllocLastFrame().system_allocs_;
+    const unsigned int allocs = AllocLastFrameCount() -
+                                AllocLastFrame(kAllocTag_Audio).allocs_;
+    if (allocs == 0 && physics == 0){ continue; }
+
+    if (failed++ < kMaxReports){
+      printf("frame %u allocated:", frame);
+      for (unsigned short int i = 0; i < kAllocTag_Count; i++){
+        if (i == kAllocTag_Audio){ continue; }
+        const AllocStats& stats = AllocLastFrame((AllocTag)i);
+        if (stats.allocs_ > 0){
+          printf(" %s %u (%u bytes)", AllocTagName((AllocTag)i),
+                 stats.allocs_, stats.bytes_);
+        }
+      }
+      if (physics > 0){ printf(" chipmunk system %u", physics); }
+      printf("\n");
+    }
+  }
+
+  printf("headless: %u frames, %u steady, %u allocating, "
+         "%u audio allocations left out\n", frames, steady, failed, audio);
+  LATENCY.report(stdout);
+  // without the hook chipmunk allocations can't be seen, don't pass blind
+  const bool hooked = ChipmunkAllocHooked();
+  if (!hooked){ printf("headless: chipmunk allocations are not counted\n"); }
+
+  JOBSYSTEM.shutdown();
+  RENDERQUEUE.flush();
+
+  return failed > 0 || !hooked ? 1 : 0;
+}
+
 int ESAT::main(int argc, char** argv){
 
+  /// no window, check the frames do not allocate
+  if (argv[1] != NULL && !strcmp(argv[1], "-headless")){
+    srand(0);
+    return RunHeadless(argv[2] != NULL ? atoi(argv[2]) : 3600);
+  }
+
   /// check for 'debug mode'
   if (argv[1] != NULL && !strncmp(argv[1], "-debug\0", strlen(argv[1]))){
     GAMEMANAGER.debug_mode_ = true;
@@ -60,6 +176,13 @@ int ESAT::main(int argc, char** argv){
   /// init scene
   GAMEMANAGER.engine_scene_->init();
 
+  /// the window owns the context, it draws while a worker simulates
+  static double frame_delta = 0.0;
+  FrameThread simulation;
+  if (!GAMEMANAGER.debug_mode_){
+    simulation.start(SimulateFrame, &frame_delta);
+  }
+
   /// game loop
   while (ESAT::WindowIsOpened() &&
          !ESAT::IsSpecialKeyDown(ESAT::kSpecialKey_Escape)){
@@ -69,8 +192,24 @@ int ESAT::main(int argc, char** argv){
     double delta_time = tick - last_time;
 
     GAMEMANAGER.engine_scene_->input();
-    GAMEMANAGER.engine_scene_->update(delta_time);
-    GAMEMANAGER.engine_scene_->render();
+    frame_delta = delta_time;
+
+    if (simulation.running()){
+      // frame N is drawn while frame N + 1 is simulated
+      simulation.kick();
+      GAMEMANAGER.engine_scene_->present();
+      simulation.wait();
+      RENDERQUEUE.swap();
+    }
+    else {
+      // the debug window edits the scene, keep it on one thread
+      SimulateFrame(&frame_delta);
+      RENDERQUEUE.swap();
+      GAMEMANAGER.engine_scene_->present();
+    }
+    ESAT::WindowFrame();
+    LATENCY.submit(RENDERQUEUE.executedSequence(), Profiler::Now());
+    EndFrame();
 
     /*
     double sleep = GAMEMANAGER.sleepMS() - (ESAT::Time() - tick);
@@ -79,6 +218,11 @@ int ESAT::main(int argc, char** argv){
     last_time = tick;
   }
 
+  LATENCY.report(stdout);
+  simulation.stop();
+  JOBSYSTEM.shutdown();
+  RENDERQUEUE.flush();
+  GlyphAtlas::ReleaseAll();
   ESAT::WindowDestroy();
 
   return 0;
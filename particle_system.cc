@@ -0,0 +1,175 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ParticleSystem Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "particle_system.h"
+
+/// color palette, index = brick kind (0 = white, 8 = red)
+static const unsigned char kPalette[ParticleSystem::kNumColors][3] = {
+  { 255, 255, 255 },
+  { 255, 255, 255 },
+  { 255, 140, 0 },
+  { 0, 200, 255 },
+  { 60, 220, 60 },
+  { 255, 60, 60 },
+  { 60, 100, 255 },
+  { 200, 200, 200 },
+  { 220, 30, 30 },
+  { 255, 220, 0 }
+};
+
+/// constructor
+ParticleSystem::ParticleSystem() {
+
+  alive_ = 0;
+  seed_ = 2463534242u;
+  gravity_ = 600.0f;
+  step_ = 0.0f;
+  size_ = 2.0f;
+}
+
+/**
+ * @brief spawn a burst of particles, the ones that do not fit in the
+ *        pool are dropped
+ * @param const gtmath::Vec3 position, const gtmath::Vec3 direction,
+ *        const unsigned short int amount, const float speed,
+ *        const float life, const unsigned char color
+ * @return void
+ **/
+void ParticleSystem::emit(const gtmath::Vec3 position,
+                          const gtmath::Vec3 direction,
+                          const unsigned short int amount,
+                          const float speed,
+                          const float life,
+                          const unsigned char color) {
+
+  unsigned int last = alive_ + amount;
+  if (last > kMaxParticles){ last = kMaxParticles; }
+
+  for (unsigned int i = alive_; i < last; i++){
+    x_[i] = position.x;
+    y_[i] = position.y;
+    // spread around the direction, a zero direction gives a full circle
+    vx_[i] = (direction.x + random()) * speed * (0.5f + random() * 0.5f);
+    vy_[i] = (direction.y + random()) * speed * (0.5f + random() * 0.5f);
+    life_[i] = life * (0.75f + random() * 0.25f);
+    color_[i] = color < kNumColors ? color : 0;
+  }
+
+  alive_ = last;
+}
+
+/**
+ * @brief integrate every live particle and discard the dead ones
+ * @param const float delta_time (seconds)
+ * @return void
+ **/
+void ParticleSystem::update(const float delta_time) {
+
+  step_ = delta_time;
+
+  // big bursts are split across the workers, chunks touch disjoint ranges
+  if (alive_ > kJobGrain){
+    JobCounter integrated;
+    JOBSYSTEM.parallelFor(Integrate, this, alive_, kJobGrain, &integrated);
+    JOBSYSTEM.wait(&integrated);
+  }
+  else { Integrate(this, 0, alive_); }
+
+  // swap the dead ones with the tail, order does not matter
+  unsigned int i = 0;
+  while (i < alive_){
+    if (life_[i] > 0.0f){
+      i++;
+      continue;
+    }
+    alive_--;
+    x_[i] = x_[alive_];
+    y_[i] = y_[alive_];
+    vx_[i] = vx_[alive_];
+    vy_[i] = vy_[alive_];
+    life_[i] = life_[alive_];
+    color_[i] = color_[alive_];
+  }
+}
+
+/// job integrating the particles [first, last)
+void ParticleSystem::Integrate(void* data,
+                               const unsigned int first,
+                               const unsigned int last) {
+
+  ParticleSystem* system = (ParticleSystem*)data;
+  const float delta_time = system->step_;
+  const float gravity = system->gravity_ * delta_time;
+
+  float* __restrict x = system->x_;
+  float* __restrict y = system->y_;
+  float* __restrict vx = system->vx_;
+  float* __restrict vy = system->vy_;
+  float* __restrict life = system->life_;
+
+  // branch free loops over contiguous arrays, vectorized by the compiler
+  for (unsigned int i = first; i < last; i++){
+    vy[i] += gravity;
+    x[i] += vx[i] * delta_time;
+    y[i] += vy[i] * delta_time;
+    life[i] -= delta_time;
+  }
+}
+
+/// draw every live particle, grouped by color
+void ParticleSystem::render() {
+
+  if (alive_ == 0){ return; }
+
+  // counting sort by color, so the fill color changes once per bucket
+  unsigned int first[kNumColors + 1];
+  for (unsigned short int c = 0; c <= kNumColors; c++){ first[c] = 0; }
+  for (unsigned int i = 0; i < alive_; i++){ first[color_[i] + 1]++; }
+  for (unsigned short int c = 0; c < kNumColors; c++){
+    first[c + 1] += first[c];
+  }
+  unsigned int next[kNumColors];
+  for (unsigned short int c = 0; c < kNumColors; c++){ next[c] = first[c]; }
+  for (unsigned int i = 0; i < alive_; i++){ order_[next[color_[i]]++] = i; }
+
+  // a bucket is one command carrying the centers of all its particles
+  for (unsigned int j = 0; j < alive_; j++){
+    centers_[j * 2] = x_[order_[j]];
+    centers_[j * 2 + 1] = y_[order_[j]];
+  }
+  for (unsigned short int c = 0; c < kNumColors; c++){
+    if (first[c] == first[c + 1]){ continue; }
+    RENDERQUEUE.quads(&centers_[first[c] * 2], first[c + 1] - first[c],
+                      size_, kPalette[c], 255);
+  }
+}
+
+/// kill every particle
+void ParticleSystem::clear() {
+
+  alive_ = 0;
+}
+
+/** getters **/
+const unsigned int ParticleSystem::alive() {
+
+  return alive_;
+}
+
+/// cheap xorshift random in [-1, 1]
+const float ParticleSystem::random() {
+
+  seed_ ^= seed_ << 13;
+  seed_ ^= seed_ >> 17;
+  seed_ ^= seed_ << 5;
+
+  return (seed_ & 0xFFFF) / 32767.5f - 1.0f;
+}
+
+/// destructor
+ParticleSystem::~ParticleSystem() {}
@@ -0,0 +1,96 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief ParticleSystem Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __PARTICLESYSTEM_H__
+#define __PARTICLESYSTEM_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <ESAT/draw.h>
+
+#include "gtmath.h"
+#include "render_queue.h"
+#include "job_system.h"
+
+class ParticleSystem {
+
+  public:
+
+    /// constructor & destructor
+    ParticleSystem();
+    ~ParticleSystem();
+
+    /**
+     * @brief spawn a burst of particles, the ones that do not fit in the
+     *        pool are dropped
+     * @param const gtmath::Vec3 position, const gtmath::Vec3 direction,
+     *        const unsigned short int amount, const float speed,
+     *        const float life, const unsigned char color
+     * @return void
+     **/
+    void emit(const gtmath::Vec3 position,
+              const gtmath::Vec3 direction,
+              const unsigned short int amount,
+              const float speed,
+              const float life,
+              const unsigned char color);
+
+    /**
+     * @brief integrate every live particle and discard the dead ones
+     * @param const float delta_time (seconds)
+     * @return void
+     **/
+    void update(const float delta_time);
+
+    /// draw every live particle, one queue command per color
+    void render();
+
+    /// kill every particle
+    void clear();
+
+    /** getters **/
+    const unsigned int alive();
+
+    /// public consts
+    static const unsigned int kMaxParticles = 32768;
+    static const unsigned char kNumColors = 10;
+    static const unsigned int kJobGrain = 4096; // particles per job
+
+  private:
+
+    /// copy constructor
+    ParticleSystem(const ParticleSystem& copy);
+    ParticleSystem operator=(const ParticleSystem& copy);
+
+    /// cheap xorshift random in [-1, 1]
+    const float random();
+
+    /// job integrating the particles [first, last)
+    static void Integrate(void* data,
+                          const unsigned int first,
+                          const unsigned int last);
+
+    /// private vars (structure of arrays, one entry per live particle)
+    float x_[kMaxParticles];
+    float y_[kMaxParticles];
+    float vx_[kMaxParticles];
+    float vy_[kMaxParticles];
+    float life_[kMaxParticles];
+    unsigned char color_[kMaxParticles];
+    unsigned int order_[kMaxParticles]; // render order, bucketed by color
+    float centers_[kMaxParticles * 2]; // x, y in render order
+    unsigned int alive_;
+    unsigned int seed_;
+    float step_; // seconds, of the update being integrated
+    float gravity_;
+    float size_;
+};
+
+#endif
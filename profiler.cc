@@ -0,0 +1,83 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Profiler Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "profiler.h"
+
+/// singleton
+Profiler& Profiler::instance() {
+
+  static Profiler* singleton = new Profiler();
+  return *singleton;
+}
+
+/// constructor
+Profiler::Profiler() {
+
+  const char* kNames[kProfileSection_Count] = {
+    "Update",
+    "Physics",
+    "Particles Update",
+    "Particles Render",
+    "Render",
+    "Draw",
+    "Sync",
+    "Job Scheduling"
+  };
+
+  for (unsigned short int i = 0; i < kProfileSection_Count; i++){
+    samples_[i].name_ = kNames[i];
+  }
+  reset();
+}
+
+/**
+ * @brief mark the start / end of a section
+ * @param const ProfileSection section
+ * @return void
+ **/
+void Profiler::begin(const ProfileSection section) {
+
+  samples_[section].start_ = Now();
+}
+
+void Profiler::end(const ProfileSection section) {
+
+  const double kSmoothing = 0.05;
+
+  ProfileSample* sample = &samples_[section];
+  sample->last_ = Now() - sample->start_;
+  sample->average_ += (sample->last_ - sample->average_) * kSmoothing;
+  if (sample->last_ > sample->peak_){ sample->peak_ = sample->last_; }
+}
+
+/// forget peaks and averages
+void Profiler::reset() {
+
+  for (unsigned short int i = 0; i < kProfileSection_Count; i++){
+    samples_[i].start_ = 0.0;
+    samples_[i].last_ = 0.0;
+    samples_[i].average_ = 0.0;
+    samples_[i].peak_ = 0.0;
+  }
+}
+
+/// current time in ms
+const double Profiler::Now() {
+
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** getters **/
+const ProfileSample& Profiler::sample(const ProfileSection section) {
+
+  return samples_[section];
+}
+
+/// destructor
+Profiler::~Profiler() {}
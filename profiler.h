@@ -0,0 +1,89 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Profiler Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__ 1
+
+#include <chrono>
+
+#define PROFILER Profiler::instance()
+
+static enum ProfileSection {
+  kProfileSection_Update = 0,
+  kProfileSection_Physics,
+  kProfileSection_ParticlesUpdate,
+  kProfileSection_ParticlesRender,
+  kProfileSection_Render,
+  kProfileSection_Draw,
+  kProfileSection_Sync,
+  kProfileSection_Jobs,
+  kProfileSection_Count
+};
+
+struct ProfileSample {
+  const char* name_;
+  double start_; // ms
+  double last_; // ms spent the last time the section ran
+  double average_; // ms, exponential moving average
+  double peak_; // ms
+};
+
+class Profiler {
+
+  public:
+
+    /// singleton
+    static Profiler& instance();
+
+    /**
+     * @brief mark the start / end of a section
+     * @param const ProfileSection section
+     * @return void
+     **/
+    void begin(const ProfileSection section);
+    void end(const ProfileSection section);
+
+    /// forget peaks and averages
+    void reset();
+
+    /// current time in ms
+    static const double Now();
+
+    /** getters **/
+    const ProfileSample& sample(const ProfileSection section);
+
+  private:
+
+    /// constructor & destructor
+    Profiler();
+    ~Profiler();
+
+    /// copy constructor
+    Profiler(const Profiler& copy);
+    Profiler operator=(const Profiler& copy);
+
+    /// private vars
+    ProfileSample samples_[kProfileSection_Count];
+};
+
+/// times a section for as long as it lives
+class ProfileScope {
+
+  public:
+
+    ProfileScope(const ProfileSection section) : section_(section) {
+      PROFILER.begin(section_);
+    }
+    ~ProfileScope() { PROFILER.end(section_); }
+
+  private:
+
+    ProfileSection section_;
+};
+
+#endif
@@ -0,0 +1,316 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief RenderQueue Class
+ * @author Toni Marquez
+ *
+ **/
+
+#include "render_queue.h"
+
+/// constructor
+RenderQueue::RenderQueue() {
+
+  for (unsigned short int i = 0; i < 2; i++){
+    lists_[i].commands_.reserve(1024);
+    // every live particle center plus the paths and lines of a frame
+    lists_[i].points_.reserve(kReservedPoints);
+    lists_[i].chars_.reserve(1024);
+    lists_[i].releases_.reserve(64);
+    lists_[i].sequence_ = 0;
+  }
+  recording_ = 0;
+  executed_sequence_ = 0;
+}
+
+/// singleton
+RenderQueue& RenderQueue::instance() {
+
+  static RenderQueue* singleton = new RenderQueue();
+  return *singleton;
+}
+
+/** recording, from the simulation thread **/
+void RenderQueue::sprite(const ESAT::SpriteHandle sprite,
+                         const ESAT::SpriteTransform& transform) {
+
+  RenderCommand command;
+  command.kind_ = kRenderCommand_Sprite;
+  command.sprite_ = sprite;
+  command.transform_ = transform;
+  lists_[recording_].commands_.push_back(command);
+}
+
+/**
+ * @brief record a closed path, stroke and fill share color
+ * @param const float* points, const unsigned short int num_points,
+ *        const unsigned char* color (rgb),
+ *        const unsigned char stroke_alpha, const unsigned char fill_alpha,
+ *        const bool stroke_path
+ * @return void
+ **/
+void RenderQueue::path(const float* points,
+                       const unsigned short int num_points,
+                       const unsigned char* color,
+                       const unsigned char stroke_alpha,
+                       const unsigned char fill_alpha,
+                       const bool stroke_path) {
+
+  RenderList& list = lists_[recording_];
+
+  RenderCommand command;
+  command.kind_ = kRenderCommand_Path;
+  command.sprite_ = NULL;
+  command.first_ = list.points_.size();
+  command.count_ = num_points;
+  memcpy(command.stroke_, color, 3);
+  command.stroke_[3] = stroke_alpha;
+  memcpy(command.fill_, color, 3);
+  command.fill_[3] = fill_alpha;
+  command.stroke_path_ = stroke_path;
+  list.commands_.push_back(command);
+  list.points_.insert(list.points_.end(), points, points + num_points * 2);
+}
+
+/**
+ * @brief record many filled squares of one color as one command
+ * @param const float* centers (x, y each), const unsigned int num_quads,
+ *        const float half_size, const unsigned char* color (rgb),
+ *        const unsigned char alpha
+ * @return void
+ **/
+void RenderQueue::quads(const float* centers,
+                        const unsigned int num_quads,
+                        const float half_size,
+                        const unsigned char* color,
+                        const unsigned char alpha) {
+
+  RenderList& list = lists_[recording_];
+
+  // count_ is 16 bits, a bigger batch goes as several commands
+  unsigned int done = 0;
+  while (done < num_quads){
+    const unsigned int count = num_quads - done < 0xFFFF ?
+                               num_quads - done : 0xFFFF;
+    RenderCommand command;
+    command.kind_ = kRenderCommand_Quads;
+    command.sprite_ = NULL;
+    command.transform_.scale_x = half_size;
+    command.first_ = list.points_.size();
+    command.count_ = (unsigned short int)count;
+    memcpy(command.stroke_, color, 3);
+    command.stroke_[3] = 0;
+    memcpy(command.fill_, color, 3);
+    command.fill_[3] = alpha;
+    command.stroke_path_ = false;
+    list.commands_.push_back(command);
+    list.points_.insert(list.points_.end(), centers + done * 2,
+                        centers + (done + count) * 2);
+    done += count;
+  }
+}
+
+void RenderQueue::line(const float x1, const float y1,
+                       const float x2, const float y2,
+                       const unsigned char* color,
+                       const unsigned char alpha) {
+
+  RenderList& list = lists_[recording_];
+
+  RenderCommand command;
+  command.kind_ = kRenderCommand_Line;
+  command.sprite_ = NULL;
+  command.first_ = list.points_.size();
+  command.count_ = 2;
+  memcpy(command.stroke_, color, 3);
+  command.stroke_[3] = alpha;
+  list.commands_.push_back(command);
+  list.points_.push_back(x1);
+  list.points_.push_back(y1);
+  list.points_.push_back(x2);
+  list.points_.push_back(y2);
+}
+
+void RenderQueue::text(const char* font,
+                       const unsigned short int size,
+                       const unsigned char* color,
+                       const unsigned char alpha,
+                       const float x, const float y,
+                       const char* string) {
+
+  RenderList& list = lists_[recording_];
+
+  RenderCommand command;
+  command.kind_ = kRenderCommand_Text;
+  command.sprite_ = NULL;
+  command.transform_.x = x;
+  command.transform_.y = y;
+  command.first_ = list.chars_.size();
+  command.count_ = size;
+  memcpy(command.stroke_, color, 3);
+  command.stroke_[3] = alpha;
+  memcpy(command.fill_, color, 3);
+  command.fill_[3] = alpha;
+  list.commands_.push_back(command);
+  list.chars_.insert(list.chars_.end(), font, font + strlen(font) + 1);
+  list.chars_.insert(list.chars_.end(), string, string + strlen(string) + 1);
+}
+
+/**
+ * @brief release a sprite once the frames that may still draw it are
+ *        done, on the thread that owns the context
+ * @param const ESAT::SpriteHandle sprite
+ * @return void
+ **/
+void RenderQueue::release(const ESAT::SpriteHandle sprite) {
+
+  if (sprite == NULL){ return; }
+
+  lists_[recording_].releases_.push_back(sprite);
+}
+
+/// tag the recorded frame with the newest input it reacts to
+void RenderQueue::stamp(const unsigned int sequence) {
+
+  lists_[recording_].sequence_ = sequence;
+}
+
+/// the recorded frame becomes the one to draw
+void RenderQueue::swap() {
+
+  recording_ = 1 - recording_;
+
+  // keeps the capacity, recording a frame does not allocate once warm
+  RenderList& list = lists_[recording_];
+  list.commands_.clear();
+  list.points_.clear();
+  list.chars_.clear();
+  list.sequence_ = 0;
+}
+
+/// replay the frame to draw, from the thread that owns the context
+void RenderQueue::execute() {
+
+  RenderList& list = lists_[1 - recording_];
+
+  // only touch the backend state when it changes
+  unsigned int stroke = 0;
+  unsigned int fill = 0;
+  bool has_stroke = false;
+  bool has_fill = false;
+  const char* font = nullptr;
+  unsigned short int font_size = 0;
+
+  for (unsigned int i = 0; i < list.commands_.size(); i++){
+    const RenderCommand& command = list.commands_[i];
+
+    if (command.kind_ != kRenderCommand_Sprite){
+      unsigned int color = 0;
+      memcpy(&color, command.stroke_, 4);
+      if (!has_stroke || color != stroke){
+        ESAT::DrawSetStrokeColor(command.stroke_[0], command.stroke_[1],
+                                 command.stroke_[2], command.stroke_[3]);
+        stroke = color;
+        has_stroke = true;
+      }
+    }
+    if (command.kind_ == kRenderCommand_Path ||
+        command.kind_ == kRenderCommand_Quads ||
+        command.kind_ == kRenderCommand_Text){
+      unsigned int color = 0;
+      memcpy(&color, command.fill_, 4);
+      if (!has_fill || color != fill){
+        ESAT::DrawSetFillColor(command.fill_[0], command.fill_[1],
+                               command.fill_[2], command.fill_[3]);
+        fill = color;
+        has_fill = true;
+      }
+    }
+
+    switch (command.kind_){
+      case kRenderCommand_Sprite: {
+        ESAT::DrawSprite(command.sprite_, command.transform_);
+      } break;
+      case kRenderCommand_Path: {
+        ESAT::DrawSolidPath(&list.points_[command.first_], command.count_,
+                            command.stroke_path_);
+      } break;
+      case kRenderCommand_Quads: {
+        // the backend has no batch call, the queue only stores centers
+        const float* centers = &list.points_[command.first_];
+        const float half = command.transform_.scale_x;
+        float quad[10];
+        for (unsigned int q = 0; q < command.count_; q++){
+          const float x = centers[q * 2];
+          const float y = centers[q * 2 + 1];
+          quad[0] = x - half;
+          quad[1] = y - half;
+          quad[2] = x + half;
+          quad[3] = y - half;
+          quad[4] = x + half;
+          quad[5] = y + half;
+          quad[6] = x - half;
+          quad[7] = y + half;
+          quad[8] = quad[0];
+          quad[9] = quad[1];
+          ESAT::DrawSolidPath(quad, 5, false);
+        }
+      } break;
+      case kRenderCommand_Line: {
+        const float* points = &list.points_[command.first_];
+        ESAT::DrawLine(points[0], points[1], points[2], points[3]);
+      } break;
+      case kRenderCommand_Text: {
+        const char* command_font = &list.chars_[command.first_];
+        const char* string = command_font + strlen(command_font) + 1;
+        if (font == nullptr || strcmp(font, command_font)){
+          ESAT::DrawSetTextFont(command_font);
+          font = command_font;
+        }
+        if (font_size != command.count_){
+          ESAT::DrawSetTextSize(command.count_);
+          font_size = command.count_;
+        }
+        ESAT::DrawText(command.transform_.x, command.transform_.y, string);
+      } break;
+      default: break;
+    }
+  }
+
+  // nothing drawn from now on can reference these
+  for (unsigned int i = 0; i < list.releases_.size(); i++){
+    ESAT::SpriteRelease(list.releases_[i]);
+  }
+  list.releases_.clear();
+  executed_sequence_ = list.sequence_;
+}
+
+/// release every pending sprite, on shutdown
+void RenderQueue::flush() {
+
+  for (unsigned short int i = 0; i < 2; i++){
+    for (unsigned int j = 0; j < lists_[i].releases_.size(); j++){
+      ESAT::SpriteRelease(lists_[i].releases_[j]);
+    }
+    lists_[i].releases_.clear();
+  }
+}
+
+/** getters **/
+const unsigned int RenderQueue::numCommands() {
+
+  return lists_[1 - recording_].commands_.size();
+}
+
+const unsigned int RenderQueue::executedSequence() {
+
+  return executed_sequence_;
+}
+
+const unsigned int RenderQueue::swappedSequence() {
+
+  return lists_[1 - recording_].sequence_;
+}
+
+/// destructor
+RenderQueue::~RenderQueue() {}
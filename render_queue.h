@@ -0,0 +1,148 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief RenderQueue Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __RENDERQUEUE_H__
+#define __RENDERQUEUE_H__ 1
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include <ESAT/draw.h>
+#include <ESAT/sprite.h>
+
+#define RENDERQUEUE RenderQueue::instance()
+
+// floats a frame records without growing: 2 per particle (32768 of them)
+// and 8192 for the paths and lines of the rest of the frame
+static const unsigned int kReservedPoints = 32768 * 2 + 8192;
+
+static enum RenderCommandKind {
+  kRenderCommand_None = 0,
+  kRenderCommand_Sprite,
+  kRenderCommand_Path,
+  kRenderCommand_Quads, // squares of one color, a center each
+  kRenderCommand_Line,
+  kRenderCommand_Text
+};
+
+/// one draw call, with everything it needs copied in
+struct RenderCommand {
+  RenderCommandKind kind_;
+  ESAT::SpriteHandle sprite_;
+  ESAT::SpriteTransform transform_; // also the text position, quad size
+  unsigned int first_; // first float in points_ / char in chars_
+  unsigned short int count_; // path points / quads / text size
+  unsigned char stroke_[4];
+  unsigned char fill_[4];
+  bool stroke_path_;
+};
+
+/// every command of a frame
+struct RenderList {
+  std::vector<RenderCommand> commands_;
+  std::vector<float> points_;
+  std::vector<char> chars_; // font and text, zero terminated
+  std::vector<ESAT::SpriteHandle> releases_;
+  unsigned int sequence_; // newest input the frame reacts to
+};
+
+class RenderQueue {
+
+  public:
+
+    /// singleton
+    static RenderQueue& instance();
+
+    /** recording, from the simulation thread **/
+    void sprite(const ESAT::SpriteHandle sprite,
+                const ESAT::SpriteTransform& transform);
+
+    /**
+     * @brief record a closed path, stroke and fill share color
+     * @param const float* points, const unsigned short int num_points,
+     *        const unsigned char* color (rgb),
+     *        const unsigned char stroke_alpha, const unsigned char fill_alpha,
+     *        const bool stroke_path
+     * @return void
+     **/
+    void path(const float* points,
+              const unsigned short int num_points,
+              const unsigned char* color,
+              const unsigned char stroke_alpha,
+              const unsigned char fill_alpha,
+              const bool stroke_path = true);
+
+    /**
+     * @brief record many filled squares of one color as one command
+     * @param const float* centers (x, y each), const unsigned int num_quads,
+     *        const float half_size, const unsigned char* color (rgb),
+     *        const unsigned char alpha
+     * @return void
+     **/
+    void quads(const float* centers,
+               const unsigned int num_quads,
+               const float half_size,
+               const unsigned char* color,
+               const unsigned char alpha);
+
+    void line(const float x1, const float y1,
+              const float x2, const float y2,
+              const unsigned char* color,
+              const unsigned char alpha);
+
+    void text(const char* font,
+              const unsigned short int size,
+              const unsigned char* color,
+              const unsigned char alpha,
+              const float x, const float y,
+              const char* string);
+
+    /**
+     * @brief release a sprite once the frames that may still draw it are
+     *        done, on the thread that owns the context
+     * @param const ESAT::SpriteHandle sprite
+     * @return void
+     **/
+    void release(const ESAT::SpriteHandle sprite);
+
+    /// tag the recorded frame with the newest input it reacts to
+    void stamp(const unsigned int sequence);
+
+    /// the recorded frame becomes the one to draw
+    void swap();
+
+    /// replay the frame to draw, from the thread that owns the context
+    void execute();
+
+    /// release every pending sprite, on shutdown
+    void flush();
+
+    /** getters **/
+    const unsigned int numCommands();
+    const unsigned int executedSequence(); // of the last executed frame
+    const unsigned int swappedSequence(); // of the frame to draw, headless
+
+  private:
+
+    /// constructor & destructor
+    RenderQueue();
+    ~RenderQueue();
+
+    /// copy constructor
+    RenderQueue(const RenderQueue& copy);
+    RenderQueue operator=(const RenderQueue& copy);
+
+    /// private vars
+    RenderList lists_[2];
+    unsigned short int recording_; // the other list is the one to draw
+    unsigned int executed_sequence_;
+};
+
+#endif
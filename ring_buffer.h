@@ -0,0 +1,100 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief RingBuffer Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __RINGBUFFER_H__
+#define __RINGBUFFER_H__ 1
+
+#include <atomic>
+
+/**
+ *  fixed capacity single producer / single consumer queue. It never
+ *  allocates and never locks: the producer only writes head_, the consumer
+ *  only writes tail_. kCapacity must be a power of two and one slot is
+ *  always kept free to tell full from empty.
+ **/
+template <typename T, unsigned int kCapacity>
+class RingBuffer {
+
+  static_assert((kCapacity & (kCapacity - 1)) == 0,
+                "RingBuffer capacity must be a power of two");
+
+  public:
+
+    /// constructor & destructor
+    RingBuffer() : head_(0), tail_(0) {}
+    ~RingBuffer() {}
+
+    /**
+     * @brief push an item (producer side), false when the buffer is full
+     * @param const T& item
+     * @return const bool
+     **/
+    const bool push(const T& item) {
+
+      unsigned int head = head_.load(std::memory_order_relaxed);
+      unsigned int next = (head + 1) & (kCapacity - 1);
+      if (next == tail_.load(std::memory_order_acquire)){ return false; }
+
+      items_[head] = item;
+      head_.store(next, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * @brief pop the oldest item (consumer side), false when it is empty
+     * @param T* item
+     * @return const bool
+     **/
+    const bool pop(T* item) {
+
+      unsigned int tail = tail_.load(std::memory_order_relaxed);
+      if (tail == head_.load(std::memory_order_acquire)){ return false; }
+
+      *item = items_[tail];
+      tail_.store((tail + 1) & (kCapacity - 1), std::memory_order_release);
+      return true;
+    }
+
+    /// drop every pending item (consumer side)
+    void clear() {
+
+      tail_.store(head_.load(std::memory_order_acquire),
+                  std::memory_order_release);
+    }
+
+    /** getters **/
+    const bool empty() {
+
+      return head_.load(std::memory_order_acquire) ==
+             tail_.load(std::memory_order_acquire);
+    }
+
+    const unsigned int size() {
+
+      return (head_.load(std::memory_order_acquire) -
+              tail_.load(std::memory_order_acquire)) & (kCapacity - 1);
+    }
+
+    const unsigned int capacity() {
+
+      return kCapacity - 1;
+    }
+
+  private:
+
+    /// copy constructor
+    RingBuffer(const RingBuffer& copy);
+    RingBuffer operator=(const RingBuffer& copy);
+
+    /// private vars
+    T items_[kCapacity];
+    std::atomic<unsigned int> head_;
+    std::atomic<unsigned int> tail_;
+};
+
+#endif
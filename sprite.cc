@@ -7,11 +7,46 @@
 
 #include "sprite.h"
 
+/// a loaded file and the Sprites using it
+struct SpriteFile {
+  char path_[128];
+  ESAT::SpriteHandle handle_;
+  unsigned short int width_;
+  unsigned short int height_;
+  unsigned short int references_;
+};
+
+static SpriteFile g_files[Sprite::kMaxFiles];
+static bool g_headless = false;
+
+/// width and height from the IHDR chunk, right after the signature
+static bool ReadPNGSize(const char* path,
+                        unsigned short int* width,
+                        unsigned short int* height) {
+
+  unsigned char header[24];
+  FILE* file = fopen(path, "rb");
+  if (file == NULL){ return false; }
+  size_t read = fread(header, 1, 24, file);
+  fclose(file);
+
+  if (read < 24 || memcmp(header + 1, "PNG", 3) ||
+      memcmp(header + 12, "IHDR", 4)){
+    return false;
+  }
+  *width = (header[18] << 8) | header[19];
+  *height = (header[22] << 8) | header[23];
+
+  return true;
+}
+
 /// constructor
 Sprite::Sprite() {
 
   handle_ = NULL;
   ESAT::SpriteTransformInit(&transform_);
+  width_ = 0.0f;
+  height_ = 0.0f;
   memset(handle_path_, 0, 128);
   centered_pivot_ = false;
 }
@@ -21,7 +56,8 @@ void Sprite::init(const char* handle_path,
                   const gtmath::Vec3 position,
                   const bool centered_pivot) {
 
-  handle_ = ESAT::SpriteFromFile(handle_path);
+  handle_ = Acquire(handle_path);
+  fetchSize();
   sprintf(handle_path_, "%s", handle_path);
   centered_pivot_ = centered_pivot;
   transform_.x = position.x;
@@ -36,13 +72,127 @@ void Sprite::init(const char* handle_path,
 /// render on screen
 void Sprite::render() {
 
-  ESAT::DrawSprite(handle_, transform_);
+  RENDERQUEUE.sprite(handle_, transform_);
+}
+
+/**
+ * @brief load a file once, every Sprite of that path shares the handle
+ * @param const char* handle_path
+ * @return ESAT::SpriteHandle
+ **/
+ESAT::SpriteHandle Sprite::Acquire(const char* handle_path) {
+
+  SpriteFile* free_file = nullptr;
+  for (unsigned short int i = 0; i < kMaxFiles; i++){
+    if (g_files[i].references_ == 0){
+      if (free_file == nullptr){ free_file = &g_files[i]; }
+    }
+    else if (!strcmp(g_files[i].path_, handle_path)){
+      g_files[i].references_++;
+      return g_files[i].handle_;
+    }
+  }
+
+  if (g_headless){
+    // the file entry stands for the handle, nothing draws it
+    if (free_file == nullptr ||
+        !ReadPNGSize(handle_path, &free_file->width_, &free_file->height_)){
+      printf("Error: can't read the size of %s\n", handle_path);
+      return NULL;
+    }
+    snprintf(free_file->path_, 128, "%s", handle_path);
+    free_file->handle_ = (ESAT::SpriteHandle)free_file;
+    free_file->references_ = 1;
+    return free_file->handle_;
+  }
+
+  ESAT::SpriteHandle handle = ESAT::SpriteFromFile(handle_path);
+  if (free_file != nullptr && handle != NULL){
+    snprintf(free_file->path_, 128, "%s", handle_path);
+    free_file->handle_ = handle;
+    free_file->width_ = ESAT::SpriteWidth(handle);
+    free_file->height_ = ESAT::SpriteHeight(handle);
+    free_file->references_ = 1;
+  }
+
+  return handle;
+}
+
+/// drop a reference, the last one releases through the render queue
+void Sprite::Release(const ESAT::SpriteHandle handle) {
+
+  if (handle == NULL){ return; }
+
+  for (unsigned short int i = 0; i < kMaxFiles; i++){
+    if (g_files[i].references_ > 0 && g_files[i].handle_ == handle){
+      g_files[i].references_--;
+      if (g_files[i].references_ > 0){ return; }
+      break;
+    }
+  }
+
+  if (g_headless){ return; }
+
+  // frames already recorded may still draw it
+  RENDERQUEUE.release(handle);
+}
+
+/**
+ * @brief without a window nothing is loaded, files only give their
+ *        size (read from the png header) so bodies keep their shape
+ * @param const bool headless
+ * @return void
+ **/
+void Sprite::SetHeadless(const bool headless) {
+
+  g_headless = headless;
+}
+
+const bool Sprite::Headless() {
+
+  return g_headless;
+}
+
+/**
+ * @brief size of the file behind a handle, unscaled
+ * @param const ESAT::SpriteHandle handle, float* width, float* height
+ * @return void
+ **/
+void Sprite::Size(const ESAT::SpriteHandle handle,
+                  float* width,
+                  float* height) {
+
+  *width = 0.0f;
+  *height = 0.0f;
+  if (handle == NULL){ return; }
+
+  for (unsigned short int i = 0; i < kMaxFiles; i++){
+    if (g_files[i].references_ > 0 && g_files[i].handle_ == handle){
+      *width = g_files[i].width_;
+      *height = g_files[i].height_;
+      return;
+    }
+  }
+
+  // not shared, the table was full when it loaded
+  *width = ESAT::SpriteWidth(handle);
+  *height = ESAT::SpriteHeight(handle);
+}
+
+/// size of the file behind handle_
+void Sprite::fetchSize() {
+
+  Size(handle_, &width_, &height_);
 }
 
 /** setters **/
 void Sprite::set_sprite(const char* handle_path) {
 
-  handle_ = ESAT::SpriteFromFile(handle_path);
+  ESAT::SpriteHandle handle = Acquire(handle_path);
+  Release(handle_);
+  handle_ = handle;
+  fetchSize();
+  sprintf(handle_path_, "%s", handle_path);
 }
 
 void Sprite::set_pivot(const gtmath::Vec3 pivot) {
@@ -71,12 +221,12 @@ void Sprite::set_rotation(const float rotation) {
 /** getters **/
 const float Sprite::width() {
 
-  return (ESAT::SpriteWidth(handle_) * transform_.scale_x);
+  return (width_ * transform_.scale_x);
 }
 
 const float Sprite::height() {
 
-  return (ESAT::SpriteHeight(handle_) * transform_.scale_y);
+  return (height_ * transform_.scale_y);
 }
 
 const gtmath::Vec3 Sprite::position() {
@@ -91,5 +241,5 @@ const gtmath::Vec3 Sprite::position() {
 /// destructor
 Sprite::~Sprite() {
 
-  ESAT::SpriteRelease(handle_);
+  Release(handle_);
 }
@@ -17,6 +17,7 @@
 #include <ESAT/input.h>
 
 #include "gtmath.h"
+#include "render_queue.h"
 
 class Sprite {
 
@@ -41,6 +42,37 @@ class Sprite {
     void set_scale(const gtmath::Vec3 scale);
     void set_rotation(const float rotation);
 
+    /**
+     * @brief load a file once, every Sprite of that path shares the handle
+     * @param const char* handle_path
+     * @return ESAT::SpriteHandle
+     **/
+    static ESAT::SpriteHandle Acquire(const char* handle_path);
+
+    /// drop a reference, the last one releases through the render queue
+    static void Release(const ESAT::SpriteHandle handle);
+
+    /**
+     * @brief size of the file behind a handle, unscaled
+     * @param const ESAT::SpriteHandle handle, float* width, float* height
+     * @return void
+     **/
+    static void Size(const ESAT::SpriteHandle handle,
+                     float* width,
+                     float* height);
+
+    /// max different files loaded at once
+    static const unsigned short int kMaxFiles = 64;
+
+    /**
+     * @brief without a window nothing is loaded, files only give their
+     *        size (read from the png header) so bodies keep their shape
+     * @param const bool headless
+     * @return void
+     **/
+    static void SetHeadless(const bool headless);
+    static const bool Headless();
+
     /** getters **/
     const float width();
     const float height();
@@ -52,9 +84,14 @@ class Sprite {
     Sprite(const Sprite& copy);
     Sprite operator=(const Sprite& copy);
 
+    /// size of the file behind handle_
+    void fetchSize();
+
     /// private vars
     ESAT::SpriteHandle handle_;
     ESAT::SpriteTransform transform_;
+    float width_; // of the file, unscaled
+    float height_;
     char handle_path_[128];
     bool centered_pivot_;
 };
@@ -0,0 +1,72 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Sweep Functions
+ * @author Toni Marquez
+ *
+ **/
+
+#include "sweep.h"
+
+/**
+ * @brief sweep a moving axis aligned box against a static one
+ * @param const gtmath::Vec3 center, const gtmath::Vec3 half,
+ *        const gtmath::Vec3 delta, const gtmath::Vec3 box_center,
+ *        const gtmath::Vec3 box_half, SweepHit* hit
+ * @return const bool
+ **/
+const bool SweepBox(const gtmath::Vec3 center,
+                    const gtmath::Vec3 half,
+                    const gtmath::Vec3 delta,
+                    const gtmath::Vec3 box_center,
+                    const gtmath::Vec3 box_half,
+                    SweepHit* hit) {
+
+  const float kEpsilon = 0.00001f;
+
+  const float origin[2] = { center.x, center.y };
+  const float direction[2] = { delta.x, delta.y };
+  const float min[2] = { box_center.x - box_half.x - half.x,
+                         box_center.y - box_half.y - half.y };
+  const float max[2] = { box_center.x + box_half.x + half.x,
+                         box_center.y + box_half.y + half.y };
+
+  float t_near = -INFINITY;
+  float t_far = INFINITY;
+  unsigned short int near_axis = 0;
+
+  for (unsigned short int axis = 0; axis < 2; axis++){
+    if (fabs(direction[axis]) < kEpsilon){
+      // parallel to this slab, must already be inside it
+      if (origin[axis] <= min[axis] || origin[axis] >= max[axis]){
+        return false;
+      }
+      continue;
+    }
+
+    float t1 = (min[axis] - origin[axis]) / direction[axis];
+    float t2 = (max[axis] - origin[axis]) / direction[axis];
+    if (t1 > t2){
+      float temp = t1;
+      t1 = t2;
+      t2 = temp;
+    }
+
+    if (t1 > t_near){
+      t_near = t1;
+      near_axis = axis;
+    }
+    if (t2 < t_far){ t_far = t2; }
+    if (t_near > t_far){ return false; }
+  }
+
+  // starting inside or touching later than this motion
+  if (t_near < 0.0f || t_near > 1.0f){ return false; }
+
+  hit->toi = t_near;
+  hit->normal = gtmath::Vec3Zero();
+  if (near_axis == 0){ hit->normal.x = direction[0] > 0.0f ? -1.0f : 1.0f; }
+  else { hit->normal.y = direction[1] > 0.0f ? -1.0f : 1.0f; }
+
+  return true;
+}
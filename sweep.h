@@ -0,0 +1,40 @@
+/**
+ *
+ * @project Arkanoid
+ * @brief Sweep Header
+ * @author Toni Marquez
+ *
+ **/
+
+#ifndef __SWEEP_H__
+#define __SWEEP_H__ 1
+
+#include <math.h>
+
+#include "gtmath.h"
+
+struct SweepHit {
+  float toi; // time of impact, 0 = start of the motion, 1 = end
+  gtmath::Vec3 normal;
+};
+
+/**
+ * @brief sweep a moving axis aligned box against a static one
+ * @param const gtmath::Vec3 center, const gtmath::Vec3 half,
+ *        const gtmath::Vec3 delta, const gtmath::Vec3 box_center,
+ *        const gtmath::Vec3 box_half, SweepHit* hit
+ * @return const bool
+ **/
+const bool SweepBox(const gtmath::Vec3 center,
+                    const gtmath::Vec3 half,
+                    const gtmath::Vec3 delta,
+                    const gtmath::Vec3 box_center,
+                    const gtmath::Vec3 box_half,
+                    SweepHit* hit);
+/**
+ *  the static box is inflated by the moving half extents (minkowski sum),
+ *  so the test becomes a ray (center -> center + delta) against a box
+ *  using the slab method. Only approaching hits inside [0, 1] are reported.
+ **/
+
+#endif
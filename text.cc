@@ -18,6 +18,8 @@ Text::Text() {
   color_[2] = 0;
   alpha_ = 0;
   size_ = 0;
+  atlas_ = nullptr;
+  num_quads_ = 0;
 }
 
 /// init values
@@ -35,22 +37,60 @@ void Text::init(const char* text,
   color_[2] = color.z;
   alpha_ = 255;
   sprintf(font_, "%s", font);
+
+  atlas_ = GlyphAtlas::Get(font_, size_, color_);
+  layout();
+}
+
+/// place every glyph of text_ relative to position_
+void Text::layout() {
+
+  num_quads_ = 0;
+  if (atlas_ == nullptr){ return; }
+
+  float pen = 0.0f;
+  // ESAT draws text from the baseline, the atlas from the top of the line
+  float top = -atlas_->ascent();
+  for (const char* c = text_; *c != '\0'; c++){
+    const Glyph* glyph = atlas_->glyph(*c);
+    if (glyph == nullptr){ continue; }
+
+    if (glyph->sprite_ != NULL){
+      quads_[num_quads_].sprite_ = glyph->sprite_;
+      quads_[num_quads_].x_ = pen + glyph->x_offset_;
+      quads_[num_quads_].y_ = top + glyph->y_offset_;
+      num_quads_++;
+    }
+    pen += glyph->advance_;
+  }
 }
 
 /// draw on screen
 void Text::render() {
 
-  ESAT::DrawSetTextFont(font_);
-  ESAT::DrawSetStrokeColor(color_[0], color_[1], color_[2], alpha_);
-  ESAT::DrawSetFillColor(color_[0], color_[1], color_[2], alpha_);
-  ESAT::DrawSetTextSize(size_);
-  ESAT::DrawText(position_.x, position_.y, text_);
+  // the atlas bakes an opaque color, faded text goes through the font path
+  if (atlas_ != nullptr && alpha_ == 255){
+    ESAT::SpriteTransform transform;
+    ESAT::SpriteTransformInit(&transform);
+    for (unsigned short int i = 0; i < num_quads_; i++){
+      transform.x = position_.x + quads_[i].x_;
+      transform.y = position_.y + quads_[i].y_;
+      RENDERQUEUE.sprite(quads_[i].sprite_, transform);
+    }
+    return;
+  }
+
+  RENDERQUEUE.text(font_, size_, color_, alpha_,
+                   position_.x, position_.y, text_);
 }
 
 /** setters **/
 void Text::set_text(const char* string) {
 
-  sprintf(text_, "%s", string);
+  if (!strcmp(text_, string)){ return; }
+
+  snprintf(text_, 512, "%s", string);
+  layout();
 }
 
 void Text::set_position(const gtmath::Point position) {
@@ -64,6 +104,11 @@ void Text::set_color(const gtmath::Vec3 color) {
   color_[0] = (unsigned char)color.x;
   color_[1] = (unsigned char)color.y;
   color_[2] = (unsigned char)color.z;
+
+  if (size_ > 0){
+    atlas_ = GlyphAtlas::Get(font_, size_, color_);
+    layout();
+  }
 }
 
 void Text::set_alpha(const unsigned char alpha) {
@@ -13,8 +13,11 @@
 #include <string.h>
 
 #include <ESAT/draw.h>
+#include <ESAT/sprite.h>
 
 #include "gtmath.h"
+#include "render_queue.h"
+#include "glyph_atlas.h"
 
 class Text {
 
@@ -50,6 +53,16 @@ class Text {
     Text(const Text& copy);
     Text operator=(const Text& copy);
 
+    /// place every glyph of text_ relative to position_
+    void layout();
+
+    /// one glyph already placed, drawn as a sprite
+    struct GlyphQuad {
+      ESAT::SpriteHandle sprite_;
+      float x_;
+      float y_;
+    };
+
     /// private vars
     gtmath::Point position_;
     char text_[512];
@@ -57,6 +70,10 @@ class Text {
     unsigned char color_[3];
     unsigned char alpha_;
     unsigned short int size_;
+
+    GlyphAtlas* atlas_; // nullptr falls back to ESAT::DrawText
+    GlyphQuad quads_[512];
+    unsigned short int num_quads_;
 };
 
 #endif